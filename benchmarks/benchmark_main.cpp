@@ -0,0 +1,163 @@
+#include "harness.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/** @file benchmark_main.cpp
+ *  @brief Runs the registered benchmarks and writes the results as JSON
+ *
+ *  Usage: benchmark_sigma [--filter <text>] [--min-time <seconds>]
+ *                         [--fan-in <n>]... [--threads <n>]...
+ *                         [--repetitions <n>] [--out <file>]
+ *
+ *  Only benchmarks whose "family/name" contains the filter text are run. Each
+ *  is run at every fan-in and thread count given, by default the fan-ins of
+ *  harness.hpp and OpenMP's default number of threads, e.g.
+ *  `--filter eigen/square --threads 1 --threads 8 --threads 32` for the
+ *  scaling of matrix products. The JSON is written to stdout unless an output
+ *  file is given, and progress is reported on stderr.
+ */
+
+namespace benchmarks {
+namespace {
+
+/// Escape a string for a JSON document, including its control characters
+std::string json_string(const std::string& s) {
+    constexpr char hex[] = "0123456789abcdef";
+    std::string escaped  = "\"";
+    for(char c : s) {
+        const auto u = static_cast<unsigned char>(c);
+        if(u < 0x20) {
+            escaped += "\\u00";
+            escaped += hex[u >> 4];
+            escaped += hex[u & 0xf];
+            continue;
+        }
+        if(c == '"' || c == '\\') escaped += '\\';
+        escaped += c;
+    }
+    return escaped + "\"";
+}
+
+} // namespace
+
+void write_json(std::ostream& os, const std::vector<Result>& results) {
+#ifdef NDEBUG
+    const bool debug = false;
+#else
+    const bool debug = true;
+#endif
+#ifdef __VERSION__
+    const std::string compiler = __VERSION__;
+#else
+    const std::string compiler = "unknown";
+#endif
+#ifdef _OPENMP
+    const bool openmp = true;
+#else
+    const bool openmp = false;
+#endif
+    os << "{\n  \"context\": {\n"
+       << "    \"compiler\": " << json_string(compiler) << ",\n"
+       << "    \"debug\": " << (debug ? "true" : "false") << ",\n"
+       << "    \"openmp\": " << (openmp ? "true" : "false") << "\n"
+       << "  },\n  \"benchmarks\": [";
+    for(std::size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        os << (i == 0 ? "\n" : ",\n") << "    {\"family\": "
+           << json_string(r.family) << ", \"name\": " << json_string(r.name)
+           << ", \"fan_in\": " << r.fan_in << ", \"threads\": " << r.threads
+           << ", \"repetitions\": " << r.repetitions
+           << ", \"iterations\": " << r.iterations
+           << ", \"ns_per_op\": " << r.ns_per_op
+           << ", \"ns_per_op_min\": " << r.ns_per_op_min
+           << ", \"result_deps\": " << r.result_deps << "}";
+    }
+    os << "\n  ]\n}\n";
+}
+
+} // namespace benchmarks
+
+int main(int argc, char* argv[]) {
+    std::string filter, out;
+    double min_time         = 0.05;
+    std::size_t repetitions = 3;
+    std::vector<std::size_t> fan_ins;
+    std::vector<int> threads;
+    for(int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if(i + 1 == argc) {
+            std::cerr << "Missing value for " << arg << "\n";
+            return EXIT_FAILURE;
+        }
+        const std::string value = argv[++i];
+        if(arg == "--filter") {
+            filter = value;
+        } else if(arg == "--min-time") {
+            min_time = std::stod(value);
+        } else if(arg == "--fan-in") {
+            fan_ins.push_back(std::stoul(value));
+        } else if(arg == "--threads") {
+            threads.push_back(std::stoi(value));
+        } else if(arg == "--repetitions") {
+            repetitions = std::max<std::size_t>(std::stoul(value), 1);
+        } else if(arg == "--out") {
+            out = value;
+        } else {
+            std::cerr << "Unknown option " << arg << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+    if(fan_ins.empty()) fan_ins = benchmarks::fan_ins;
+#ifdef _OPENMP
+    if(threads.empty()) threads.push_back(omp_get_max_threads());
+#else
+    if(!threads.empty()) std::cerr << "Built without OpenMP, using 1 thread\n";
+    threads = {1};
+#endif
+
+    std::vector<benchmarks::Result> results;
+    for(const auto& b : benchmarks::registry()) {
+        const std::string id = b.family + "/" + b.name;
+        if(id.find(filter) == std::string::npos) continue;
+        for(auto n_threads : threads) {
+#ifdef _OPENMP
+            omp_set_num_threads(n_threads);
+#endif
+            for(auto fan_in : fan_ins) {
+                std::vector<benchmarks::Result> runs;
+                for(std::size_t r = 0; r < repetitions; ++r) {
+                    benchmarks::State state(fan_in, min_time);
+                    b.body(state);
+                    runs.push_back({b.family, b.name, fan_in, n_threads,
+                                    repetitions, state.iterations(),
+                                    state.ns_per_op(), state.ns_per_op(),
+                                    state.result_deps()});
+                }
+                std::sort(runs.begin(), runs.end(),
+                          [](const auto& lhs, const auto& rhs) {
+                              return lhs.ns_per_op < rhs.ns_per_op;
+                          });
+                auto median          = runs[runs.size() / 2];
+                median.ns_per_op_min = runs.front().ns_per_op;
+                results.push_back(median);
+                std::cerr << id << " [" << fan_in << ", " << n_threads
+                          << " threads]: " << median.ns_per_op << " ns\n";
+            }
+        }
+    }
+
+    if(out.empty()) {
+        benchmarks::write_json(std::cout, results);
+    } else {
+        std::ofstream file(out);
+        benchmarks::write_json(file, results);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,209 @@
+#pragma once
+#include "../tests/fixtures.hpp"
+#include <sigma/sigma.hpp>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/** @file harness.hpp
+ *  @brief A minimal timing harness for the benchmarks
+ *
+ *  Benchmarks register themselves with BENCHMARK, in the same way that tests
+ *  register themselves with Catch2. Each benchmark is run once per fan-in,
+ *  i.e. the number of independent variables its inputs depend on, and per
+ *  number of OpenMP threads. Each measurement is repeated, and the results
+ *  are written as JSON so that runs can be compared.
+ */
+
+namespace benchmarks {
+
+/// The value type of the benchmarked variables
+using uncertain_t = sigma::UDouble;
+
+/// The fan-ins every benchmark is run at
+inline const std::vector<std::size_t> fan_ins{1, 10, 100, 10000};
+
+/// The timing of one benchmark at one fan-in
+struct Result {
+    /// The group of the benchmark, e.g. the operation family
+    std::string family;
+
+    /// The name of the benchmark
+    std::string name;
+
+    /// The number of dependencies of each input
+    std::size_t fan_in;
+
+    /// The number of OpenMP threads, 1 without OpenMP
+    int threads;
+
+    /// The number of times the measurement was repeated
+    std::size_t repetitions;
+
+    /// The number of times the body was run, in the median repetition
+    std::size_t iterations;
+
+    /// The median over the repetitions of the mean time per run, in ns
+    double ns_per_op;
+
+    /// The fastest repetition's mean time per run, in nanoseconds
+    double ns_per_op_min;
+
+    /// The number of dependencies of the last result
+    std::size_t result_deps;
+};
+
+/** @brief Times the body of a benchmark
+ *
+ *  The body is run in batches of doubling size until a batch takes at least
+ *  the minimum time, and the time per run is taken from that batch. Setup
+ *  done before calling run() is not timed.
+ */
+class State {
+public:
+    /** @brief Create the state of one benchmark run
+     *
+     *  @param fan_in The number of dependencies of each input
+     *  @param min_time The minimum time of the measured batch, in seconds
+     *
+     *  @throw none No throw guarantee
+     */
+    State(std::size_t fan_in, double min_time) :
+      m_fan_in_(fan_in), m_min_time_(min_time) {}
+
+    /// The number of dependencies of each input
+    std::size_t fan_in() const { return m_fan_in_; }
+
+    /** @brief Time a body
+     *
+     *  @tparam FunctionType The type of the body, which returns an Uncertain
+     *                       value, an array of them, or a double
+     *  @param body The code being timed
+     *
+     *  @throw Any exception thrown by @p body. Same throw guarantee.
+     */
+    template<typename FunctionType>
+    void run(FunctionType&& body) {
+        using clock_t = std::chrono::steady_clock;
+        for(std::size_t batch = 1;; batch *= 2) {
+            auto start = clock_t::now();
+            for(std::size_t i = 0; i < batch; ++i) keep(body());
+            std::chrono::duration<double> elapsed = clock_t::now() - start;
+            if(elapsed.count() >= m_min_time_ || batch >= max_batch) {
+                m_iterations_ = batch;
+                m_ns_per_op_  = 1.0e9 * elapsed.count() / double(batch);
+                return;
+            }
+        }
+    }
+
+    /// The number of times the body was run in the measured batch
+    std::size_t iterations() const { return m_iterations_; }
+
+    /// The mean time per run of the body, in nanoseconds
+    double ns_per_op() const { return m_ns_per_op_; }
+
+    /// The number of dependencies of the last result
+    std::size_t result_deps() const { return m_result_deps_; }
+
+private:
+    /// Batches are never larger than this
+    static constexpr std::size_t max_batch = std::size_t{1} << 30;
+
+    /// Keep a result observable, so that computing it is not optimized away
+    template<typename PolicyType>
+    void keep(const sigma::Uncertain<double, PolicyType>& x) {
+        m_result_deps_ = x.deps().size();
+        m_sink_        = x.sd();
+    }
+
+    /// Keep a floating point result
+    void keep(double x) { m_sink_ = x; }
+
+    /// Keep the results of a multi-output operation
+    template<typename PolicyType, std::size_t N>
+    void keep(const std::array<sigma::Uncertain<double, PolicyType>, N>& xs) {
+        for(const auto& x : xs) keep(x);
+    }
+
+    /// The number of dependencies of each input
+    std::size_t m_fan_in_;
+
+    /// The minimum time of the measured batch, in seconds
+    double m_min_time_;
+
+    /// The number of runs in the measured batch
+    std::size_t m_iterations_ = 0;
+
+    /// The mean time per run, in nanoseconds
+    double m_ns_per_op_ = 0.0;
+
+    /// The number of dependencies of the last result
+    std::size_t m_result_deps_ = 0;
+
+    /// Written by every run of the body
+    volatile double m_sink_ = 0.0;
+};
+
+/// A registered benchmark
+struct Benchmark {
+    /// The group of the benchmark, e.g. the operation family
+    std::string family;
+
+    /// The name of the benchmark
+    std::string name;
+
+    /// Sets up the inputs for the fan-in of the state and calls State::run
+    std::function<void(State&)> body;
+};
+
+/// The registered benchmarks, in registration order
+inline std::vector<Benchmark>& registry() {
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+/// Registers a benchmark at static initialization
+struct Registrar {
+    Registrar(std::string family, std::string name,
+              std::function<void(State&)> body) {
+        registry().push_back({std::move(family), std::move(name),
+                              std::move(body)});
+    }
+};
+
+/// A value that depends on a number of independent variables
+using testing::fan_in_value;
+
+/** @brief Write results as JSON
+ *
+ *  @param os The stream to write to
+ *  @param results The results to write
+ *
+ *  @throws std::ios_base::failure if anything goes wrong while writing.
+ *          Weak throw guarantee.
+ */
+void write_json(std::ostream& os, const std::vector<Result>& results);
+
+} // namespace benchmarks
+
+#define BENCHMARK_CAT_(a, b) a##b
+#define BENCHMARK_CAT(a, b) BENCHMARK_CAT_(a, b)
+
+/** @def BENCHMARK(family, name)
+ *  @brief Define and register a benchmark
+ *
+ *  The body that follows has access to a `benchmarks::State& state`.
+ */
+#define BENCHMARK(family, name)                                          \
+    static void BENCHMARK_CAT(benchmark_fn_, __LINE__)(                  \
+      benchmarks::State & state);                                        \
+    static benchmarks::Registrar BENCHMARK_CAT(benchmark_reg_, __LINE__)( \
+      family, name, &BENCHMARK_CAT(benchmark_fn_, __LINE__));            \
+    static void BENCHMARK_CAT(benchmark_fn_, __LINE__)(                  \
+      [[maybe_unused]] benchmarks::State & state)
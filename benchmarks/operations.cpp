@@ -0,0 +1,180 @@
+#include "harness.hpp"
+#include <sigma/sigma.hpp>
+#include <vector>
+
+/** @file operations.cpp
+ *  @brief Benchmarks of the operations in sigma/operations
+ *
+ *  Unary operations act on one value with the given fan-in. Binary and
+ *  multi-output operations act on values whose dependencies are disjoint, so
+ *  the result depends on the fan-in times the number of inputs.
+ */
+
+namespace {
+
+using benchmarks::fan_in_value;
+using benchmarks::State;
+using benchmarks::uncertain_t;
+
+/// A unary operation, with a mean inside its domain
+struct Unary {
+    const char* family;
+    const char* name;
+    double mean;
+    uncertain_t (*op)(const uncertain_t&);
+};
+
+/// A binary operation, with means inside its domain
+struct Binary {
+    const char* family;
+    const char* name;
+    double a_mean;
+    double b_mean;
+    uncertain_t (*op)(const uncertain_t&, const uncertain_t&);
+};
+
+#define UNARY(family, op, mean) \
+    Unary { family, #op, mean, [](const uncertain_t& a) { return op(a); } }
+
+#define BINARY(family, op, a_mean, b_mean)                            \
+    Binary {                                                          \
+        family, #op, a_mean, b_mean,                                  \
+          [](const uncertain_t& a, const uncertain_t& b) { return op(a, b); } \
+    }
+
+#define OPERATOR(family, symbol, a_mean, b_mean)                         \
+    Binary {                                                             \
+        family, "operator" #symbol, a_mean, b_mean,                      \
+          [](const uncertain_t& a, const uncertain_t& b) { return a symbol b; } \
+    }
+
+using namespace sigma;
+
+const std::vector<Unary> unary_ops{
+  UNARY("arithmetic", operator-, 0.5),
+  Unary{"arithmetic", "operator*(double)", 0.5,
+        [](const uncertain_t& a) { return a * 2.0; }},
+  Unary{"arithmetic", "operator+(double)", 0.5,
+        [](const uncertain_t& a) { return a + 2.0; }},
+  Unary{"arithmetic", "operator/(double, Uncertain)", 0.5,
+        [](const uncertain_t& a) { return 2.0 / a; }},
+  UNARY("basic", abs, -0.5),
+  UNARY("basic", fabs, -0.5),
+  UNARY("basic", ceil, 0.5),
+  UNARY("basic", floor, 0.5),
+  UNARY("basic", trunc, 0.5),
+  UNARY("basic", round, 0.5),
+  UNARY("complex", abs2, 0.5),
+  UNARY("error_and_gamma", erf, 0.5),
+  UNARY("error_and_gamma", erfc, 0.5),
+  UNARY("error_and_gamma", tgamma, 0.5),
+  UNARY("error_and_gamma", lgamma, 0.5),
+  UNARY("exponents", exp, 0.5),
+  UNARY("exponents", exp2, 0.5),
+  UNARY("exponents", expm1, 0.5),
+  UNARY("exponents", log, 0.5),
+  UNARY("exponents", log10, 0.5),
+  UNARY("exponents", log2, 0.5),
+  UNARY("exponents", log1p, 0.5),
+  UNARY("exponents", sqrt, 0.5),
+  UNARY("exponents", cbrt, 0.5),
+  Unary{"exponents", "pow(Uncertain, double)", 0.5,
+        [](const uncertain_t& a) { return pow(a, 2.5); }},
+  UNARY("hyperbolic", sinh, 0.5),
+  UNARY("hyperbolic", cosh, 0.5),
+  UNARY("hyperbolic", tanh, 0.5),
+  UNARY("hyperbolic", asinh, 0.5),
+  UNARY("hyperbolic", acosh, 1.5),
+  UNARY("hyperbolic", atanh, 0.5),
+  UNARY("trigonometry", degrees, 0.5),
+  UNARY("trigonometry", radians, 0.5),
+  UNARY("trigonometry", sin, 0.5),
+  UNARY("trigonometry", cos, 0.5),
+  UNARY("trigonometry", tan, 0.5),
+  UNARY("trigonometry", asin, 0.5),
+  UNARY("trigonometry", acos, 0.5),
+  UNARY("trigonometry", atan, 0.5),
+  Unary{"multi_output", "frexp", 0.5,
+        [](const uncertain_t& a) { return frexp(a).first; }}};
+
+const std::vector<Binary> binary_ops{
+  OPERATOR("arithmetic", +, 0.5, 0.25),
+  OPERATOR("arithmetic", -, 0.5, 0.25),
+  OPERATOR("arithmetic", *, 0.5, 0.25),
+  OPERATOR("arithmetic", /, 0.5, 0.25),
+  BINARY("basic", copysign, 0.5, -0.25),
+  BINARY("basic", fmod, 0.5, 0.25),
+  BINARY("exponents", pow, 0.5, 0.25),
+  BINARY("trigonometry", atan2, 0.5, 0.25),
+  BINARY("trigonometry", hypot, 0.5, 0.25)};
+
+#undef UNARY
+#undef BINARY
+#undef OPERATOR
+
+const bool registered = [] {
+    for(const auto& u : unary_ops) {
+        benchmarks::Registrar(u.family, u.name, [u](State& state) {
+            const uncertain_t a = fan_in_value(state.fan_in(), u.mean);
+            state.run([&]() { return u.op(a); });
+        });
+    }
+    for(const auto& b : binary_ops) {
+        benchmarks::Registrar(b.family, b.name, [b](State& state) {
+            const uncertain_t x = fan_in_value(state.fan_in(), b.a_mean);
+            const uncertain_t y = fan_in_value(state.fan_in(), b.b_mean);
+            state.run([&]() { return b.op(x, y); });
+        });
+    }
+    return true;
+}();
+
+} // namespace
+
+BENCHMARK("arithmetic", "operator+=") {
+    const uncertain_t a = fan_in_value(state.fan_in(), 0.5);
+    const uncertain_t b = fan_in_value(state.fan_in(), 0.25);
+    state.run([&]() {
+        uncertain_t c(a);
+        c += b;
+        return c;
+    });
+}
+
+BENCHMARK("arithmetic", "operator*=(double)") {
+    const uncertain_t a = fan_in_value(state.fan_in(), 0.5);
+    state.run([&]() {
+        uncertain_t c(a);
+        c *= 2.0;
+        return c;
+    });
+}
+
+BENCHMARK("multi_output", "sincos") {
+    const uncertain_t a = fan_in_value(state.fan_in(), 0.5);
+    state.run([&]() { return sigma::sincos(a); });
+}
+
+BENCHMARK("multi_output", "modf") {
+    const uncertain_t a = fan_in_value(state.fan_in(), 1.5);
+    state.run([&]() { return sigma::modf(a); });
+}
+
+BENCHMARK("multi_output", "to_polar") {
+    const uncertain_t x = fan_in_value(state.fan_in(), 0.5);
+    const uncertain_t y = fan_in_value(state.fan_in(), 0.25);
+    state.run([&]() { return sigma::to_polar(x, y); });
+}
+
+BENCHMARK("multi_output", "to_cartesian") {
+    const uncertain_t r     = fan_in_value(state.fan_in(), 0.5);
+    const uncertain_t theta = fan_in_value(state.fan_in(), 0.25);
+    state.run([&]() { return sigma::to_cartesian(r, theta); });
+}
+
+BENCHMARK("multi_output", "normalize") {
+    const uncertain_t x = fan_in_value(state.fan_in(), 0.5);
+    const uncertain_t y = fan_in_value(state.fan_in(), 0.25);
+    const uncertain_t z = fan_in_value(state.fan_in(), 0.75);
+    state.run([&]() { return sigma::normalize(x, y, z); });
+}
@@ -0,0 +1,226 @@
+#include "harness.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <sigma/sigma.hpp>
+#include <vector>
+
+/** @file scenarios.cpp
+ *  @brief Benchmarks of common uses of the operations
+ */
+
+using benchmarks::fan_in_value;
+using benchmarks::uncertain_t;
+
+namespace {
+
+/// Independent variables with mean 1 and standard deviation 0.01
+std::vector<uncertain_t> independent(std::size_t n) {
+    return sigma::make_independent(std::vector<double>(n, 1.0),
+                                   std::vector<double>(n, 0.01));
+}
+
+} // namespace
+
+BENCHMARK("scenarios", "copy") {
+    const uncertain_t a = fan_in_value(state.fan_in(), 0.5);
+    state.run([&]() { return uncertain_t(a); });
+}
+
+BENCHMARK("scenarios", "make_independent") {
+    const std::vector<double> means(state.fan_in(), 1.0);
+    const std::vector<double> sds(state.fan_in(), 0.01);
+    state.run([&]() { return sigma::make_independent(means, sds).back(); });
+}
+
+BENCHMARK("scenarios", "sum of independent") {
+    const auto vars = independent(state.fan_in());
+    state.run([&]() {
+        uncertain_t sum(0.0);
+        for(const auto& var : vars) sum += var;
+        return sum;
+    });
+}
+
+BENCHMARK("scenarios", "sum of correlated") {
+    // Every term depends on all of the variables
+    const uncertain_t a = fan_in_value(state.fan_in(), 0.5);
+    const std::vector<uncertain_t> terms(16, a);
+    state.run([&]() {
+        uncertain_t sum(0.0);
+        for(const auto& term : terms) sum += term;
+        return sum;
+    });
+}
+
+namespace {
+
+/// A value with the given storage that depends on @p n variables
+template<typename PolicyType>
+sigma::Uncertain<double, PolicyType> stored_value(std::size_t n, double mean) {
+    sigma::Uncertain<double, PolicyType> x(0.0);
+    for(std::size_t i = 0; i < n; ++i) {
+        x += sigma::Uncertain<double, PolicyType>(mean / double(n), 0.01);
+    }
+    return x;
+}
+
+/// The product of two values with disjoint dependencies
+template<typename PolicyType>
+void binary_with_storage(benchmarks::State& state) {
+    const auto a = stored_value<PolicyType>(state.fan_in(), 0.5);
+    const auto b = stored_value<PolicyType>(state.fan_in(), 0.25);
+    state.run([&]() { return a * b; });
+}
+
+/// A unary operation
+template<typename PolicyType>
+void unary_with_storage(benchmarks::State& state) {
+    const auto a = stored_value<PolicyType>(state.fan_in(), 0.5);
+    state.run([&]() { return sigma::exp(a); });
+}
+
+/// The product of two aggregates of the same independent variables
+template<typename PolicyType>
+void shared_binary_with_storage(benchmarks::State& state) {
+    const std::vector<double> means(state.fan_in(), 1.0);
+    const std::vector<double> sds(state.fan_in(), 0.01);
+    const auto inputs = sigma::make_independent<PolicyType>(means, sds);
+    sigma::Uncertain<double, PolicyType> a(0.0), b(0.0);
+    for(std::size_t i = 0; i < inputs.size(); ++i) {
+        a += inputs[i] * 0.5;
+        if(i % 2 == 0) b += inputs[i] * 0.25;
+    }
+    state.run([&]() { return a * b; });
+}
+
+/// Adding a value with 4 dependencies to one with all of them, in place
+template<typename PolicyType>
+void narrow_into_wide_with_storage(benchmarks::State& state) {
+    using uncertain_t = sigma::Uncertain<double, PolicyType>;
+    const std::vector<double> means(state.fan_in(), 1.0);
+    const std::vector<double> sds(state.fan_in(), 0.01);
+    const auto inputs = sigma::make_independent<PolicyType>(means, sds);
+    uncertain_t wide(0.0), narrow(0.0);
+    for(const auto& x : inputs) wide += x;
+    for(std::size_t i = 0; i < inputs.size(); i += inputs.size() / 4 + 1) {
+        narrow += inputs[i] * 1.0e-9;
+    }
+    state.run([&]() -> const uncertain_t& { return wide += narrow; });
+}
+
+} // namespace
+
+BENCHMARK("storage", "map: exp") {
+    unary_with_storage<sigma::MapStorage>(state);
+}
+
+BENCHMARK("storage", "flat: exp") {
+    unary_with_storage<sigma::FlatStorage>(state);
+}
+
+BENCHMARK("storage", "map: a * b") {
+    binary_with_storage<sigma::MapStorage>(state);
+}
+
+BENCHMARK("storage", "flat: a * b") {
+    binary_with_storage<sigma::FlatStorage>(state);
+}
+
+BENCHMARK("storage", "adaptive: exp") {
+    unary_with_storage<sigma::AdaptiveStorage>(state);
+}
+
+BENCHMARK("storage", "adaptive: a * b") {
+    binary_with_storage<sigma::AdaptiveStorage>(state);
+}
+
+BENCHMARK("storage", "map: a * b (shared inputs)") {
+    shared_binary_with_storage<sigma::MapStorage>(state);
+}
+
+BENCHMARK("storage", "flat: a * b (shared inputs)") {
+    shared_binary_with_storage<sigma::FlatStorage>(state);
+}
+
+BENCHMARK("storage", "hash: exp") {
+    unary_with_storage<sigma::HashStorage>(state);
+}
+
+BENCHMARK("storage", "hash: a * b") {
+    binary_with_storage<sigma::HashStorage>(state);
+}
+
+BENCHMARK("storage", "adaptive: a * b (shared inputs)") {
+    shared_binary_with_storage<sigma::AdaptiveStorage>(state);
+}
+
+BENCHMARK("storage", "hash: a * b (shared inputs)") {
+    shared_binary_with_storage<sigma::HashStorage>(state);
+}
+
+BENCHMARK("storage", "map: wide += narrow") {
+    narrow_into_wide_with_storage<sigma::MapStorage>(state);
+}
+
+BENCHMARK("storage", "flat: wide += narrow") {
+    narrow_into_wide_with_storage<sigma::FlatStorage>(state);
+}
+
+BENCHMARK("storage", "hash: wide += narrow") {
+    narrow_into_wide_with_storage<sigma::HashStorage>(state);
+}
+
+#ifdef ENABLE_EIGEN_SUPPORT
+#include <Eigen/Dense>
+
+/// A matrix of independent variables
+using umatrix_t = Eigen::Matrix<uncertain_t, Eigen::Dynamic, Eigen::Dynamic>;
+
+using testing::independent_matrix;
+
+BENCHMARK("eigen", "sum") {
+    const auto n = static_cast<Eigen::Index>(state.fan_in());
+    const umatrix_t v = independent_matrix<umatrix_t>(n, 1);
+    state.run([&]() { return v.sum(); });
+}
+
+BENCHMARK("eigen", "dot") {
+    // Each element of the result depends on the fan-in times two variables
+    const auto n = static_cast<Eigen::Index>(state.fan_in());
+    const umatrix_t a = independent_matrix<umatrix_t>(n, 1);
+    const umatrix_t b = independent_matrix<umatrix_t>(n, 1);
+    state.run([&]() { return a.col(0).dot(b.col(0)); });
+}
+
+BENCHMARK("eigen", "product 8 x fan-in x 8") {
+    const auto n = static_cast<Eigen::Index>(state.fan_in());
+    const umatrix_t a = independent_matrix<umatrix_t>(8, n);
+    const umatrix_t b = independent_matrix<umatrix_t>(n, 8);
+    state.run([&]() {
+        umatrix_t c = a * b;
+        return c(7, 7);
+    });
+}
+
+BENCHMARK("eigen", "square product, n = min(fan-in, 100)") {
+    // Wide enough to split across many threads; run with several --threads
+    // to see how the product scales
+    const auto n      = static_cast<Eigen::Index>(
+      std::min<std::size_t>(state.fan_in(), 100));
+    const umatrix_t a = independent_matrix<umatrix_t>(n, n);
+    const umatrix_t b = independent_matrix<umatrix_t>(n, n);
+    state.run([&]() {
+        umatrix_t c = a * b;
+        return c(n - 1, n - 1);
+    });
+}
+
+BENCHMARK("eigen", "covariance_matrix") {
+    // 16 correlated values, each depending on all of the variables
+    const uncertain_t a = fan_in_value(state.fan_in(), 0.5);
+    umatrix_t v(16, 1);
+    for(Eigen::Index i = 0; i < v.size(); ++i) v(i) = a * double(i + 1);
+    state.run([&]() { return sigma::covariance_matrix(v)(0, 0); });
+}
+
+#endif // ENABLE_EIGEN_SUPPORT
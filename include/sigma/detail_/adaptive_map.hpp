@@ -0,0 +1,672 @@
+#pragma once
+#include "sigma/detail_/flat_map.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/** @file adaptive_map.hpp
+ *  @brief Dependency storage that switches between sparse and dense layouts
+ */
+
+namespace sigma::detail_ {
+
+/** @brief The index of the lowest set bit of a non-zero word
+ *
+ *  @param word The word, which must not be zero
+ *
+ *  @return The number of trailing zero bits of @p word
+ *
+ *  @throw none No throw guarantee
+ */
+inline unsigned lowest_bit(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(word));
+#else
+    unsigned i = 0;
+    while((word & 1) == 0) {
+        word >>= 1;
+        ++i;
+    }
+    return i;
+#endif
+}
+
+/** @brief A map from cells to derivatives that adapts its layout to density
+ *
+ *  The keys are pointers to the standard deviation cells of independent
+ *  variables. A cell's address divided by the cell size is its slot, which
+ *  orders the keys like their addresses do. The cells of variables made
+ *  together by make_independent have consecutive slots.
+ *
+ *  While few of the slots between the lowest and highest key are used, the
+ *  entries are kept sparse: a vector sorted by key. Once at least
+ *  dense_min_size entries fill dense_enter of that window, the map becomes
+ *  dense: an array with one entry per slot of the window and a bitmap of the
+ *  slots in use. Lookups are then direct and merges scatter into the array.
+ *  The map returns to the sparse layout when less than dense_leave of the
+ *  window is used. The gap between the two thresholds keeps it from switching
+ *  back and forth.
+ *
+ *  @tparam KeyType A shared pointer to a cell
+ *  @tparam MappedType The type of the derivatives
+ */
+template<typename KeyType, typename MappedType>
+class AdaptiveMap {
+public:
+    /// The type of the keys
+    using key_type = KeyType;
+
+    /// The type of the mapped values
+    using mapped_type = MappedType;
+
+    /// The type of an entry
+    using value_type = std::pair<key_type, mapped_type>;
+
+    /// The ordering of the keys, by address
+    using key_compare = std::less<key_type>;
+
+    /// The type of the sizes
+    using size_type = std::size_t;
+
+    /// The fewest entries worth storing densely
+    static constexpr size_type dense_min_size = 64;
+
+    /// The fraction of the window in use above which the map becomes dense
+    static constexpr double dense_enter = 0.5;
+
+    /// The fraction of the window in use below which the map becomes sparse
+    static constexpr double dense_leave = 0.25;
+
+    /** @brief Iterator over the entries in use, in key order
+     *
+     *  @tparam IsConst Whether the entries are read-only
+     */
+    template<bool IsConst>
+    class Iterator {
+    public:
+        /// The category of the iterator
+        using iterator_category = std::forward_iterator_tag;
+
+        /// The type of the entries
+        using value_type = AdaptiveMap::value_type;
+
+        /// The type of the distance between iterators
+        using difference_type = std::ptrdiff_t;
+
+        /// A pointer to an entry
+        using pointer =
+          std::conditional_t<IsConst, const value_type*, value_type*>;
+
+        /// A reference to an entry
+        using reference =
+          std::conditional_t<IsConst, const value_type&, value_type&>;
+
+        /// @brief Default ctor
+        Iterator() = default;
+
+        /** @brief Point to an entry
+         *
+         *  @param entries The first entry of the storage
+         *  @param bits The bitmap of the dense layout, null if sparse
+         *  @param i The index of the entry
+         *  @param n The number of entries (sparse) or slots (dense)
+         */
+        Iterator(pointer entries, const std::uint64_t* bits, size_type i,
+                 size_type n) :
+          m_entries_(entries), m_bits_(bits), m_i_(i), m_n_(n) {}
+
+        /// A read-only iterator from a mutable one
+        template<bool OtherConst,
+                 typename = std::enable_if_t<IsConst && !OtherConst>>
+        Iterator(const Iterator<OtherConst>& other) :
+          m_entries_(other.m_entries_),
+          m_bits_(other.m_bits_),
+          m_i_(other.m_i_),
+          m_n_(other.m_n_) {}
+
+        /// The entry
+        reference operator*() const { return m_entries_[m_i_]; }
+
+        /// The entry
+        pointer operator->() const { return m_entries_ + m_i_; }
+
+        /// The index of the entry in the storage
+        size_type index() const { return m_i_; }
+
+        /// Move to the next entry
+        Iterator& operator++() {
+            m_i_ = m_bits_ ? next_set(m_bits_, m_i_ + 1, m_n_) : m_i_ + 1;
+            return *this;
+        }
+
+        /// Move to the next entry
+        Iterator operator++(int) {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        /// Whether two iterators point to the same entry
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs) {
+            return lhs.m_i_ == rhs.m_i_;
+        }
+
+        /// Whether two iterators point to different entries
+        friend bool operator!=(const Iterator& lhs, const Iterator& rhs) {
+            return !(lhs == rhs);
+        }
+
+    private:
+        template<bool>
+        friend class Iterator;
+
+        /// The first entry of the storage
+        pointer m_entries_ = nullptr;
+
+        /// The bitmap of the dense layout, null if sparse
+        const std::uint64_t* m_bits_ = nullptr;
+
+        /// The index of the entry
+        size_type m_i_ = 0;
+
+        /// The number of entries (sparse) or slots (dense)
+        size_type m_n_ = 0;
+    };
+
+    /// Iterator over the entries, in key order
+    using iterator = Iterator<false>;
+
+    /// Read-only iterator over the entries, in key order
+    using const_iterator = Iterator<true>;
+
+    /// @brief Default ctor
+    AdaptiveMap() = default;
+
+    /// Whether the entries are stored densely
+    bool is_dense() const noexcept { return !m_bits_.empty(); }
+
+    /// The first entry
+    iterator begin() noexcept { return make_iterator<false>(first_index()); }
+
+    /// The first entry
+    const_iterator begin() const noexcept {
+        return make_iterator<true>(first_index());
+    }
+
+    /// Just past the last entry
+    iterator end() noexcept { return make_iterator<false>(m_entries_.size()); }
+
+    /// Just past the last entry
+    const_iterator end() const noexcept {
+        return make_iterator<true>(m_entries_.size());
+    }
+
+    /// The number of entries
+    size_type size() const noexcept { return m_size_; }
+
+    /// Whether there are no entries
+    bool empty() const noexcept { return m_size_ == 0; }
+
+    /// The bytes of storage held for the entries and the bitmap
+    size_type heap_bytes() const noexcept {
+        return m_entries_.capacity() * sizeof(value_type) +
+               m_bits_.capacity() * sizeof(std::uint64_t);
+    }
+
+    /// The number of allocations made by copying the map
+    size_type copy_allocations() const noexcept {
+        return (m_entries_.empty() ? 0 : 1) + (is_dense() ? 1 : 0);
+    }
+
+    /// Remove every entry
+    void clear() noexcept {
+        m_entries_.clear();
+        m_bits_.clear();
+        m_size_ = 0;
+    }
+
+    /** @brief Reserve room for entries in the sparse layout
+     *
+     *  @param n The number of entries to make room for
+     *
+     *  @throw std::bad_alloc if the storage cannot be allocated. Strong throw
+     *         guarantee.
+     */
+    void reserve(size_type n) {
+        if(!is_dense()) m_entries_.reserve(n);
+    }
+
+    /// The entry with key @p key, or end() if there is none
+    iterator find(const key_type& key) {
+        return make_iterator<false>(find_index(key));
+    }
+
+    /// The entry with key @p key, or end() if there is none
+    const_iterator find(const key_type& key) const {
+        return make_iterator<true>(find_index(key));
+    }
+
+    /// The number of entries with key @p key, 0 or 1
+    size_type count(const key_type& key) const {
+        return find_index(key) == m_entries_.size() ? 0 : 1;
+    }
+
+    /** @brief The value mapped to a key
+     *
+     *  @param key The key
+     *
+     *  @return The value mapped to @p key
+     *
+     *  @throw std::out_of_range if there is no entry for @p key. Strong throw
+     *         guarantee.
+     */
+    const mapped_type& at(const key_type& key) const {
+        auto i = find_index(key);
+        if(i == m_entries_.size()) {
+            throw std::out_of_range("AdaptiveMap::at: no such key");
+        }
+        return m_entries_[i].second;
+    }
+
+    /** @brief The value mapped to a key, inserting a zero if there is none
+     *
+     *  @param key The key
+     *
+     *  @return The value mapped to @p key
+     *
+     *  @throw std::bad_alloc if the entry cannot be inserted. Strong throw
+     *         guarantee.
+     */
+    mapped_type& operator[](const key_type& key) {
+        auto i = find_index(key);
+        if(i == m_entries_.size()) i = insert(value_type(key, mapped_type{}));
+        return m_entries_[i].second;
+    }
+
+    /** @brief Insert an entry if its key is not present yet
+     *
+     *  @param args Forwarded to the ctor of value_type
+     *
+     *  @return The entry with the key and whether it was inserted
+     *
+     *  @throw std::bad_alloc if the entry cannot be inserted. Strong throw
+     *         guarantee.
+     */
+    template<typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        value_type entry(std::forward<Args>(args)...);
+        auto i = find_index(entry.first);
+        if(i != m_entries_.size()) return {make_iterator<false>(i), false};
+        return {make_iterator<false>(insert(std::move(entry))), true};
+    }
+
+    /** @brief Insert an entry, expecting it to go at the end
+     *
+     *  Appending in key order is constant time in either layout. The hint is
+     *  otherwise ignored.
+     *
+     *  @param args Forwarded to the ctor of value_type
+     *
+     *  @return The entry with the key
+     *
+     *  @throw std::bad_alloc if the entry cannot be inserted. Strong throw
+     *         guarantee.
+     */
+    template<typename... Args>
+    iterator emplace_hint(const_iterator, Args&&... args) {
+        return emplace(std::forward<Args>(args)...).first;
+    }
+
+    /** @brief Multiply every derivative by a factor
+     *
+     *  In the dense layout the unused slots are scaled too, which keeps the
+     *  loop free of branches; their values are never read.
+     *
+     *  @param factor The factor
+     *
+     *  @throw none No throw guarantee
+     */
+    template<typename ScaleType>
+    void scale(ScaleType factor) noexcept {
+        for(auto& entry : m_entries_) entry.second *= factor;
+    }
+
+    /** @brief The sum of the squared contributions to the variance
+     *
+     *  @return The sum over the entries of (cell * derivative)^2, skipping
+     *          zero derivatives
+     *
+     *  @throw none No throw guarantee
+     */
+    mapped_type sum_of_squares() const noexcept {
+        mapped_type sum{0.0};
+        auto add = [&sum](const value_type& entry) {
+            if(entry.second == mapped_type{0.0}) return;
+            const mapped_type x = *entry.first * entry.second;
+            sum += x * x;
+        };
+        if(!is_dense()) {
+            for(const auto& entry : m_entries_) add(entry);
+            return sum;
+        }
+        for(size_type w = 0; w < m_bits_.size(); ++w) {
+            for(auto word = m_bits_[w]; word != 0; word &= word - 1) {
+                add(m_entries_[w * 64 + lowest_bit(word)]);
+            }
+        }
+        return sum;
+    }
+
+    /** @brief Add a scaled copy of the entries of another map
+     *
+     *  The layout of the result is chosen first. It is dense if either input
+     *  is dense and the larger input alone would fill dense_leave of the
+     *  combined window; the entries of @p other are then scattered into the
+     *  slots. Otherwise the two sorted sets are merged in one pass.
+     *
+     *  @param other The entries to add, which may be *this
+     *  @param factor The factor applied to the values of @p other
+     *
+     *  @return The number of entries inserted
+     *
+     *  @throw std::bad_alloc if the storage cannot grow. Strong throw
+     *         guarantee.
+     */
+    template<typename ScaleType>
+    size_type accumulate(const AdaptiveMap& other, ScaleType factor) {
+        if(other.empty()) return 0;
+        if(&other == this) {
+            for(auto& entry : *this) entry.second += factor * entry.second;
+            return 0;
+        }
+        if(empty()) {
+            *this = other;
+            scale(factor);
+            return m_size_;
+        }
+
+        size_type n_added = 0;
+        if(dense_result(other)) {
+            const auto lo = std::min(first_slot(), other.first_slot());
+            const auto hi = std::max(last_slot(), other.last_slot());
+            to_dense(lo, hi);
+            for(const auto& [key, value] : other) {
+                const auto i = static_cast<size_type>(slot(key) - m_base_);
+                if(test(i)) {
+                    m_entries_[i].second += factor * value;
+                } else {
+                    m_entries_[i] = value_type(key, factor * value);
+                    m_bits_[i / 64] |= std::uint64_t{1} << (i % 64);
+                    ++n_added;
+                }
+            }
+            m_size_ += n_added;
+        } else {
+            if(is_dense()) to_sparse();
+            n_added = merge_sparse(other, factor);
+        }
+        rebalance();
+        return n_added;
+    }
+
+    /// Whether two maps have the same entries
+    friend bool operator==(const AdaptiveMap& lhs, const AdaptiveMap& rhs) {
+        return lhs.size() == rhs.size() &&
+               std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    /// Whether two maps have different entries
+    friend bool operator!=(const AdaptiveMap& lhs, const AdaptiveMap& rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    /// The slot of a key: the address of its cell in units of the cell size
+    static std::uintptr_t slot(const key_type& key) {
+        using cell_t = typename key_type::element_type;
+        return reinterpret_cast<std::uintptr_t>(key.get()) / sizeof(cell_t);
+    }
+
+    /// The first set index at or after @p i, or @p n if there is none
+    static size_type next_set(const std::uint64_t* bits, size_type i,
+                              size_type n) {
+        while(i < n) {
+            const auto word = bits[i / 64] >> (i % 64);
+            if(word != 0) return std::min(n, i + lowest_bit(word));
+            i = (i / 64 + 1) * 64;
+        }
+        return n;
+    }
+
+    /// Whether slot index @p i of the dense layout is in use
+    bool test(size_type i) const {
+        return (m_bits_[i / 64] >> (i % 64)) & 1;
+    }
+
+    /// An iterator to the entry at index @p i of the storage
+    template<bool IsConst>
+    Iterator<IsConst> make_iterator(size_type i) const {
+        using pointer = typename Iterator<IsConst>::pointer;
+        auto entries  = const_cast<pointer>(m_entries_.data());
+        const auto* bits = is_dense() ? m_bits_.data() : nullptr;
+        return {entries, bits, i, m_entries_.size()};
+    }
+
+    /// The index of the first entry in the storage
+    size_type first_index() const {
+        if(!is_dense()) return 0;
+        return next_set(m_bits_.data(), 0, m_entries_.size());
+    }
+
+    /// The slot of the smallest key; the map must not be empty
+    std::uintptr_t first_slot() const {
+        return is_dense() ? m_base_ : slot(m_entries_.front().first);
+    }
+
+    /// The slot of the largest key; the map must not be empty
+    std::uintptr_t last_slot() const {
+        if(is_dense()) return m_base_ + m_entries_.size() - 1;
+        return slot(m_entries_.back().first);
+    }
+
+    /// The index of the entry with key @p key, or the storage size
+    size_type find_index(const key_type& key) const {
+        return find_slot(slot(key));
+    }
+
+    /// The index of the entry in slot @p s, or the storage size
+    size_type find_slot(std::uintptr_t s) const {
+        const auto n = m_entries_.size();
+        if(is_dense()) {
+            if(s < m_base_ || s - m_base_ >= n) return n;
+            const auto i = static_cast<size_type>(s - m_base_);
+            return test(i) ? i : n;
+        }
+        auto it = sparse_bound(s);
+        if(it == m_entries_.end() || slot(it->first) != s) return n;
+        return static_cast<size_type>(it - m_entries_.begin());
+    }
+
+    /// The first entry of the sparse layout whose slot is not below @p s
+    typename std::vector<value_type>::const_iterator sparse_bound(
+      std::uintptr_t s) const {
+        auto below = [](const value_type& e, std::uintptr_t x) {
+            return slot(e.first) < x;
+        };
+        return std::lower_bound(m_entries_.begin(), m_entries_.end(), s, below);
+    }
+
+    /** @brief Insert an entry whose key is absent, returning its index
+     *
+     *  A dense map only grows its window to take the slot of the new entry if
+     *  the entries would still fill dense_leave of it. A key from another
+     *  block of cells may lie arbitrarily far away, so the map otherwise
+     *  becomes sparse first.
+     */
+    size_type insert(value_type entry) {
+        const auto s = slot(entry.first);
+        if(is_dense() && !dense_insert(s)) to_sparse();
+        if(is_dense()) {
+            to_dense(std::min(s, first_slot()), std::max(s, last_slot()));
+            const auto i  = static_cast<size_type>(s - m_base_);
+            m_entries_[i] = std::move(entry);
+            m_bits_[i / 64] |= std::uint64_t{1} << (i % 64);
+        } else {
+            m_entries_.insert(sparse_bound(s), std::move(entry));
+        }
+        ++m_size_;
+        rebalance();
+        return find_slot(s);
+    }
+
+    /** @brief Whether the dense layout is kept when inserting slot @p s
+     *
+     *  @param s The slot of the new entry; the map must be dense
+     */
+    bool dense_insert(std::uintptr_t s) const {
+        const auto lo     = std::min(s, first_slot());
+        const auto hi     = std::max(s, last_slot());
+        const auto window = static_cast<double>(hi - lo) + 1.0;
+        return static_cast<double>(m_size_ + 1) >= dense_leave * window;
+    }
+
+    /** @brief Whether the result of accumulating @p other is stored densely
+     *
+     *  @param other The map being added; neither map may be empty
+     */
+    bool dense_result(const AdaptiveMap& other) const {
+        if(!is_dense() && !other.is_dense()) return false;
+        const auto lo     = std::min(first_slot(), other.first_slot());
+        const auto hi     = std::max(last_slot(), other.last_slot());
+        const auto window = static_cast<double>(hi - lo) + 1.0;
+        const auto least  = static_cast<double>(std::max(size(), other.size()));
+        return least >= dense_leave * window;
+    }
+
+    /** @brief Store the entries densely over the slots [lo, hi]
+     *
+     *  If the map is already dense over a window within [lo, hi], growing
+     *  upwards reuses the storage.
+     *
+     *  @param lo The lowest slot of the window
+     *  @param hi The highest slot of the window
+     */
+    void to_dense(std::uintptr_t lo, std::uintptr_t hi) {
+        const auto n = static_cast<size_type>(hi - lo) + 1;
+        if(is_dense() && lo == m_base_) {
+            m_bits_.resize((n + 63) / 64, 0);
+            m_entries_.resize(n);
+            return;
+        }
+        std::vector<value_type> entries(n);
+        std::vector<std::uint64_t> bits((n + 63) / 64, 0);
+        for(auto& entry : *this) {
+            const auto i = static_cast<size_type>(slot(entry.first) - lo);
+            entries[i]   = std::move(entry);
+            bits[i / 64] |= std::uint64_t{1} << (i % 64);
+        }
+        m_entries_.swap(entries);
+        m_bits_.swap(bits);
+        m_base_ = lo;
+    }
+
+    /// Store the entries sparsely
+    void to_sparse() {
+        std::vector<value_type> entries;
+        entries.reserve(m_size_);
+        for(auto& entry : *this) entries.push_back(std::move(entry));
+        m_entries_.swap(entries);
+        m_bits_.clear();
+    }
+
+    /** @brief Switch layouts if the density has crossed a threshold
+     *
+     *  @return Whether the layout changed
+     */
+    bool rebalance() {
+        if(m_size_ == 0) return false;
+        const auto window =
+          static_cast<double>(last_slot() - first_slot()) + 1.0;
+        const auto n = static_cast<double>(m_size_);
+        if(!is_dense() && m_size_ >= dense_min_size &&
+           n >= dense_enter * window) {
+            to_dense(first_slot(), last_slot());
+            return true;
+        }
+        if(is_dense() && n < dense_leave * window) {
+            to_sparse();
+            return true;
+        }
+        return false;
+    }
+
+    /** @brief Merge the entries of @p other into the sparse layout
+     *
+     *  @param other The map being added, in either layout
+     *  @param factor The factor applied to the values of @p other
+     *
+     *  @return The number of entries inserted
+     */
+    template<typename ScaleType>
+    size_type merge_sparse(const AdaptiveMap& other, ScaleType factor) {
+        auto less = [](const value_type& entry, const key_type& key) {
+            return entry.first < key;
+        };
+
+        // Update in place when every key is already present
+        size_type n_new = 0;
+        auto i          = m_entries_.begin();
+        for(const auto& [key, value] : other) {
+            i = gallop(i, m_entries_.end(), key, less);
+            if(i == m_entries_.end() || key < i->first) ++n_new;
+        }
+        if(n_new == 0) {
+            i = m_entries_.begin();
+            for(const auto& [key, value] : other) {
+                i = gallop(i, m_entries_.end(), key, less);
+                i->second += factor * value;
+            }
+            return 0;
+        }
+
+        // Copy the runs of entries between the keys of other as blocks
+        std::vector<value_type> merged;
+        merged.reserve(m_size_ + n_new);
+        i = m_entries_.begin();
+        for(const auto& [key, value] : other) {
+            auto run_end = gallop(i, m_entries_.end(), key, less);
+            std::move(i, run_end, std::back_inserter(merged));
+            i = run_end;
+            if(i != m_entries_.end() && !(key < i->first)) {
+                merged.push_back(std::move(*i++));
+                merged.back().second += factor * value;
+            } else {
+                merged.emplace_back(key, factor * value);
+            }
+        }
+        std::move(i, m_entries_.end(), std::back_inserter(merged));
+        m_entries_.swap(merged);
+        m_size_ += n_new;
+        return n_new;
+    }
+
+    /// The entries: sorted by key if sparse, one per slot if dense
+    std::vector<value_type> m_entries_;
+
+    /// The slots in use if dense, empty if sparse
+    std::vector<std::uint64_t> m_bits_;
+
+    /// The slot of the first entry of the dense layout
+    std::uintptr_t m_base_ = 0;
+
+    /// The number of entries in use
+    size_type m_size_ = 0;
+};
+
+} // namespace sigma::detail_
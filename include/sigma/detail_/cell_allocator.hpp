@@ -0,0 +1,93 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/** @file cell_allocator.hpp
+ *  @brief Allocation of the standard deviation cells of independent variables
+ */
+
+namespace sigma::detail_ {
+
+/** @brief The number of standard deviation cells currently alive
+ *
+ *  Each cell belongs to one independent variable, so this is the number of
+ *  independent variables that are still referenced by some value.
+ */
+inline std::atomic<std::size_t>& live_cells() {
+    static std::atomic<std::size_t> count{0};
+    return count;
+}
+
+/** @brief A std::allocator that keeps track of the live cells
+ *
+ *  Used with std::allocate_shared for single cells and as the allocator of
+ *  the vector holding a block of cells. The allocations themselves are those
+ *  of std::allocator; constructing or destroying an object of the cell type
+ *  also updates live_cells(). Rebinding, e.g. to the control block type of a
+ *  shared pointer, keeps the cell type, so only the cells are counted.
+ *
+ *  @tparam T The type of the objects allocated
+ *  @tparam Cell The type of a standard deviation cell
+ */
+template<typename T, typename Cell = T>
+struct CellAllocator {
+    /// The type of the objects allocated
+    using value_type = T;
+
+    /// The same allocator for objects of type U
+    template<typename U>
+    struct rebind {
+        using other = CellAllocator<U, Cell>;
+    };
+
+    /// Default ctor
+    CellAllocator() noexcept = default;
+
+    /// Conversion from the allocator of another type
+    template<typename U>
+    CellAllocator(const CellAllocator<U, Cell>&) noexcept {}
+
+    /// Allocate storage for @p n objects
+    T* allocate(std::size_t n) { return std::allocator<T>{}.allocate(n); }
+
+    /// Release the storage of @p n objects
+    void deallocate(T* p, std::size_t n) noexcept {
+        std::allocator<T>{}.deallocate(p, n);
+    }
+
+    /// Construct an object, counting it if it is a cell
+    template<typename U, typename... Args>
+    void construct(U* p, Args&&... args) {
+        ::new(static_cast<void*>(p)) U(std::forward<Args>(args)...);
+        if constexpr(std::is_same_v<U, Cell>) {
+            live_cells().fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /// Destroy an object, counting it if it is a cell
+    template<typename U>
+    void destroy(U* p) noexcept {
+        p->~U();
+        if constexpr(std::is_same_v<U, Cell>) {
+            live_cells().fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    /// All instances are interchangeable
+    template<typename U>
+    bool operator==(const CellAllocator<U, Cell>&) const noexcept {
+        return true;
+    }
+
+    /// All instances are interchangeable
+    template<typename U>
+    bool operator!=(const CellAllocator<U, Cell>&) const noexcept {
+        return false;
+    }
+};
+
+} // namespace sigma::detail_
@@ -0,0 +1,358 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/** @file flat_map.hpp
+ *  @brief A sorted vector with the map interface used for dependencies
+ */
+
+namespace sigma::detail_ {
+
+/** @brief The first element of a sorted range that is not less than a key
+ *
+ *  Like std::lower_bound, but the search starts at @p first and steps 1, 2,
+ *  4, ... elements forward before bisecting. Finding a position d elements
+ *  in costs O(log d), so stepping through a long range to each key of a much
+ *  shorter one costs O(k log(n / k)) rather than O(n).
+ *
+ *  @tparam Iterator A random access iterator
+ *  @tparam Key The type of the key
+ *  @tparam Less Compares an element with the key
+ *  @param first The start of the range
+ *  @param last The end of the range
+ *  @param key The key
+ *  @param less Whether an element is less than the key
+ *
+ *  @return The first element in [first, last) not less than @p key
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename Iterator, typename Key, typename Less>
+Iterator gallop(Iterator first, Iterator last, const Key& key, Less less) {
+    typename std::iterator_traits<Iterator>::difference_type step = 1;
+    while(step < last - first && less(first[step - 1], key)) {
+        first += step;
+        step *= 2;
+    }
+    return std::lower_bound(first, first + std::min(step, last - first), key,
+                            less);
+}
+
+/** @brief The first element of a sorted range that is not less than a key
+ *
+ *  The mirror of gallop(), searching backwards from @p last. Cheap when the
+ *  element is close to the end of the range.
+ *
+ *  @tparam Iterator A random access iterator
+ *  @tparam Key The type of the key
+ *  @tparam Less Compares an element with the key
+ *  @param first The start of the range
+ *  @param last The end of the range
+ *  @param key The key
+ *  @param less Whether an element is less than the key
+ *
+ *  @return The first element in [first, last) not less than @p key
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename Iterator, typename Key, typename Less>
+Iterator gallop_back(Iterator first, Iterator last, const Key& key,
+                     Less less) {
+    typename std::iterator_traits<Iterator>::difference_type step = 1;
+    while(step <= last - first && !less(last[-step], key)) {
+        last -= step;
+        step *= 2;
+    }
+    return std::lower_bound(last - std::min(step - 1, last - first), last,
+                            key, less);
+}
+
+/** @brief An ordered map stored as a sorted vector of entries
+ *
+ *  Provides the subset of the std::map interface that the dependencies of an
+ *  Uncertain value need. The entries are contiguous, so iterating and merging
+ *  them is cache friendly and a value with n dependencies makes one
+ *  allocation instead of n, at the cost of moving entries when one is
+ *  inserted in the middle.
+ *
+ *  @tparam KeyType The type of the keys
+ *  @tparam MappedType The type of the mapped values
+ *  @tparam Compare The ordering of the keys
+ */
+template<typename KeyType, typename MappedType,
+         typename Compare = std::less<KeyType>>
+class FlatMap {
+public:
+    /// The type of the keys
+    using key_type = KeyType;
+
+    /// The type of the mapped values
+    using mapped_type = MappedType;
+
+    /// The type of an entry
+    using value_type = std::pair<key_type, mapped_type>;
+
+    /// The ordering of the keys
+    using key_compare = Compare;
+
+    /// The type of the sizes
+    using size_type = std::size_t;
+
+    /// The container holding the entries
+    using container_type = std::vector<value_type>;
+
+    /// Iterator over the entries, in key order
+    using iterator = typename container_type::iterator;
+
+    /// Read-only iterator over the entries, in key order
+    using const_iterator = typename container_type::const_iterator;
+
+    /// @brief Default ctor
+    FlatMap() = default;
+
+    /// The first entry
+    iterator begin() noexcept { return m_entries_.begin(); }
+
+    /// The first entry
+    const_iterator begin() const noexcept { return m_entries_.begin(); }
+
+    /// Just past the last entry
+    iterator end() noexcept { return m_entries_.end(); }
+
+    /// Just past the last entry
+    const_iterator end() const noexcept { return m_entries_.end(); }
+
+    /// The number of entries
+    size_type size() const noexcept { return m_entries_.size(); }
+
+    /// Whether there are no entries
+    bool empty() const noexcept { return m_entries_.empty(); }
+
+    /// The bytes of storage held for the entries
+    size_type heap_bytes() const noexcept {
+        return m_entries_.capacity() * sizeof(value_type);
+    }
+
+    /// The number of allocations made by copying the map
+    size_type copy_allocations() const noexcept { return empty() ? 0 : 1; }
+
+    /// Remove every entry
+    void clear() noexcept { m_entries_.clear(); }
+
+    /** @brief Reserve room for entries
+     *
+     *  @param n The number of entries to make room for
+     *
+     *  @throw std::bad_alloc if the storage cannot be allocated. Strong throw
+     *         guarantee.
+     */
+    void reserve(size_type n) { m_entries_.reserve(n); }
+
+    /// The first entry whose key is not less than @p key
+    iterator lower_bound(const key_type& key) {
+        return std::lower_bound(m_entries_.begin(), m_entries_.end(), key,
+                                entry_less{});
+    }
+
+    /// The first entry whose key is not less than @p key
+    const_iterator lower_bound(const key_type& key) const {
+        return std::lower_bound(m_entries_.begin(), m_entries_.end(), key,
+                                entry_less{});
+    }
+
+    /// The entry with key @p key, or end() if there is none
+    iterator find(const key_type& key) {
+        auto it = lower_bound(key);
+        return (it != end() && !key_compare{}(key, it->first)) ? it : end();
+    }
+
+    /// The entry with key @p key, or end() if there is none
+    const_iterator find(const key_type& key) const {
+        auto it = lower_bound(key);
+        return (it != end() && !key_compare{}(key, it->first)) ? it : end();
+    }
+
+    /// The number of entries with key @p key, 0 or 1
+    size_type count(const key_type& key) const {
+        return find(key) == end() ? 0 : 1;
+    }
+
+    /** @brief The value mapped to a key
+     *
+     *  @param key The key
+     *
+     *  @return The value mapped to @p key
+     *
+     *  @throw std::out_of_range if there is no entry for @p key. Strong throw
+     *         guarantee.
+     */
+    const mapped_type& at(const key_type& key) const {
+        auto it = find(key);
+        if(it == end()) throw std::out_of_range("FlatMap::at: no such key");
+        return it->second;
+    }
+
+    /** @brief The value mapped to a key, inserting a zero if there is none
+     *
+     *  @param key The key
+     *
+     *  @return The value mapped to @p key
+     *
+     *  @throw std::bad_alloc if the entry cannot be inserted. Strong throw
+     *         guarantee.
+     */
+    mapped_type& operator[](const key_type& key) {
+        auto it = lower_bound(key);
+        if(it == end() || key_compare{}(key, it->first)) {
+            it = m_entries_.emplace(it, key, mapped_type{});
+        }
+        return it->second;
+    }
+
+    /** @brief Insert an entry if its key is not present yet
+     *
+     *  @param args Forwarded to the ctor of value_type
+     *
+     *  @return The entry with the key and whether it was inserted
+     *
+     *  @throw std::bad_alloc if the entry cannot be inserted. Strong throw
+     *         guarantee.
+     */
+    template<typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        value_type entry(std::forward<Args>(args)...);
+        auto it = lower_bound(entry.first);
+        if(it != end() && !key_compare{}(entry.first, it->first)) {
+            return {it, false};
+        }
+        return {m_entries_.insert(it, std::move(entry)), true};
+    }
+
+    /** @brief Insert an entry, expecting it to go just before @p hint
+     *
+     *  Appending in key order, i.e. with end() as the hint, is constant time.
+     *  A wrong hint is ignored.
+     *
+     *  @param hint Where the entry is expected to go
+     *  @param args Forwarded to the ctor of value_type
+     *
+     *  @return The entry with the key
+     *
+     *  @throw std::bad_alloc if the entry cannot be inserted. Strong throw
+     *         guarantee.
+     */
+    template<typename... Args>
+    iterator emplace_hint(const_iterator hint, Args&&... args) {
+        value_type entry(std::forward<Args>(args)...);
+        key_compare less;
+        const bool after_prev =
+          hint == begin() || less(std::prev(hint)->first, entry.first);
+        const bool before_hint =
+          hint == end() || less(entry.first, hint->first);
+        if(after_prev && before_hint) {
+            return m_entries_.insert(hint, std::move(entry));
+        }
+        return emplace(std::move(entry)).first;
+    }
+
+    /** @brief Add a scaled copy of the entries of another map
+     *
+     *  Entries of @p other whose keys are already present are added to the
+     *  existing values; the others are inserted. Each key of @p other is
+     *  located by galloping from the previous one, and the new entries are
+     *  merged in place from the back, moving the runs of entries between
+     *  them as blocks. At most one reallocation is made. Adding k entries to
+     *  a map of n costs O(k log(n / k)) comparisons, and only the entries
+     *  above the smallest new key are moved. @p other may be *this.
+     *
+     *  @param other The entries to add
+     *  @param scale The factor applied to the values of @p other
+     *
+     *  @return The number of entries inserted
+     *
+     *  @throw std::bad_alloc if the storage cannot grow. Strong throw
+     *         guarantee.
+     */
+    template<typename ScaleType>
+    size_type accumulate(const FlatMap& other, ScaleType scale) {
+        key_compare less;
+
+        // Count the keys of other that are missing here
+        size_type n_new = 0;
+        auto i          = begin();
+        for(const auto& [key, value] : other) {
+            i = gallop(i, end(), key, entry_less{});
+            if(i == end() || less(key, i->first)) {
+                ++n_new;
+            } else {
+                ++i;
+            }
+        }
+
+        if(n_new == 0) {
+            i = begin();
+            for(const auto& [key, value] : other) {
+                i = gallop(i, end(), key, entry_less{});
+                i->second += scale * value;
+                ++i;
+            }
+            return 0;
+        }
+
+        // Grow, then merge from the back so nothing is overwritten early
+        const auto n_old = size();
+        m_entries_.resize(n_old + n_new);
+        auto out  = m_entries_.end();
+        auto last = m_entries_.begin() + n_old; // End of the unmerged entries
+        auto j    = other.m_entries_.end();
+        while(out != last) {
+            --j;
+            auto pos = gallop_back(begin(), last, j->first, entry_less{});
+            if(pos != last && !less(j->first, pos->first)) {
+                out = std::move_backward(pos + 1, last, out);
+                pos->second += scale * j->second;
+                *--out = std::move(*pos);
+            } else {
+                out    = std::move_backward(pos, last, out);
+                *--out = value_type(j->first, scale * j->second);
+            }
+            last = pos;
+        }
+
+        // Every new key is placed; the entries below have not moved
+        while(j != other.m_entries_.begin()) {
+            --j;
+            last = gallop_back(begin(), last, j->first, entry_less{});
+            last->second += scale * j->second;
+        }
+        return n_new;
+    }
+
+    /// Whether two maps have the same entries
+    friend bool operator==(const FlatMap& lhs, const FlatMap& rhs) {
+        return lhs.m_entries_ == rhs.m_entries_;
+    }
+
+    /// Whether two maps have different entries
+    friend bool operator!=(const FlatMap& lhs, const FlatMap& rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    /// Compares an entry with a key
+    struct entry_less {
+        bool operator()(const value_type& entry, const key_type& key) const {
+            return key_compare{}(entry.first, key);
+        }
+    };
+
+    /// The entries, sorted by key
+    container_type m_entries_;
+};
+
+} // namespace sigma::detail_
@@ -0,0 +1,87 @@
+#pragma once
+#include "sigma/detail_/adaptive_map.hpp"
+#include "sigma/detail_/flat_map.hpp"
+#include "sigma/detail_/hash_map.hpp"
+#include <cstddef>
+
+/** @file footprint.hpp
+ *  @brief The storage held by the containers of dependencies
+ *
+ *  Used by the memory estimates and by the allocation counters of stats.hpp.
+ *  The generic versions describe a node based container like std::map; the
+ *  contiguous containers report their own storage.
+ */
+
+namespace sigma::detail_ {
+
+/** @brief The estimated bytes held by a container of dependencies
+ *
+ *  The generic version, for std::map. Each entry is its own red-black tree
+ *  node, which holds its color and three links along with the entry.
+ *
+ *  @tparam MapType The type of the dependency container
+ *  @param deps The dependencies
+ *
+ *  @return The estimated number of bytes allocated for @p deps
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename MapType>
+std::size_t deps_bytes(const MapType& deps) {
+    using entry_t = typename MapType::value_type;
+    return deps.size() * (4 * sizeof(void*) + sizeof(entry_t));
+}
+
+/// The version for FlatMap, one vector of entries
+template<typename K, typename V>
+std::size_t deps_bytes(const FlatMap<K, V>& deps) {
+    return deps.heap_bytes();
+}
+
+/// The version for AdaptiveMap, the entries and the bitmap of the dense layout
+template<typename K, typename V>
+std::size_t deps_bytes(const AdaptiveMap<K, V>& deps) {
+    return deps.heap_bytes();
+}
+
+/// The version for HashMap, the entries and the hash table
+template<typename K, typename V>
+std::size_t deps_bytes(const HashMap<K, V>& deps) {
+    return deps.heap_bytes();
+}
+
+/** @brief The number of allocations made by copying a container
+ *
+ *  The generic version, for std::map, which allocates a node per entry.
+ *
+ *  @tparam MapType The type of the dependency container
+ *  @param deps The dependencies
+ *
+ *  @return The number of allocations a copy of @p deps makes
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename MapType>
+std::size_t deps_copy_allocations(const MapType& deps) {
+    return deps.size();
+}
+
+/// The version for FlatMap
+template<typename K, typename V>
+std::size_t deps_copy_allocations(const FlatMap<K, V>& deps) {
+    return deps.copy_allocations();
+}
+
+/// The version for AdaptiveMap
+template<typename K, typename V>
+std::size_t deps_copy_allocations(const AdaptiveMap<K, V>& deps) {
+    return deps.copy_allocations();
+}
+
+/// The version for HashMap
+template<typename K, typename V>
+std::size_t deps_copy_allocations(const HashMap<K, V>& deps) {
+    return deps.copy_allocations();
+}
+
+} // namespace sigma::detail_
@@ -0,0 +1,330 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/** @file hash_map.hpp
+ *  @brief Dependency storage indexed by an open-addressing hash table
+ */
+
+namespace sigma::detail_ {
+
+/** @brief A map from cells to derivatives with constant time lookups
+ *
+ *  The keys are pointers to the standard deviation cells of independent
+ *  variables, identified by the address of the cell divided by the cell
+ *  size. The entries are kept in a vector in insertion order; they are not
+ *  sorted by key.
+ *
+ *  Small maps are searched linearly. Once a map holds index_min_size
+ *  entries it also keeps an open-addressing table with linear probing,
+ *  which maps the ID of each key to the position of its entry. The IDs are
+ *  stored in the table itself, so a probe never touches the entries. The
+ *  table is at most half full, and grows by doubling.
+ *
+ *  Adding k entries to a map of n entries then costs O(k), instead of the
+ *  O(n) of merging two sorted sets.
+ *
+ *  @tparam KeyType A shared pointer to a cell
+ *  @tparam MappedType The type of the derivatives
+ */
+template<typename KeyType, typename MappedType>
+class HashMap {
+public:
+    /// The type of the keys
+    using key_type = KeyType;
+
+    /// The type of the mapped values
+    using mapped_type = MappedType;
+
+    /// The type of an entry
+    using value_type = std::pair<key_type, mapped_type>;
+
+    /// The ordering of the keys, used by code that sorts the entries
+    using key_compare = std::less<key_type>;
+
+    /// The type of the sizes
+    using size_type = std::size_t;
+
+    /// The container holding the entries
+    using container_type = std::vector<value_type>;
+
+    /// Iterator over the entries, in insertion order
+    using iterator = typename container_type::iterator;
+
+    /// Read-only iterator over the entries, in insertion order
+    using const_iterator = typename container_type::const_iterator;
+
+    /// The fewest entries for which the hash table is kept
+    static constexpr size_type index_min_size = 16;
+
+    /// @brief Default ctor
+    HashMap() = default;
+
+    /// Whether the entries are indexed by the hash table
+    bool is_indexed() const noexcept { return !m_table_.empty(); }
+
+    /// The first entry
+    iterator begin() noexcept { return m_entries_.begin(); }
+
+    /// The first entry
+    const_iterator begin() const noexcept { return m_entries_.begin(); }
+
+    /// Just past the last entry
+    iterator end() noexcept { return m_entries_.end(); }
+
+    /// Just past the last entry
+    const_iterator end() const noexcept { return m_entries_.end(); }
+
+    /// The number of entries
+    size_type size() const noexcept { return m_entries_.size(); }
+
+    /// Whether there are no entries
+    bool empty() const noexcept { return m_entries_.empty(); }
+
+    /// The bytes of storage held for the entries and the hash table
+    size_type heap_bytes() const noexcept {
+        return m_entries_.capacity() * sizeof(value_type) +
+               m_table_.capacity() * sizeof(Bucket);
+    }
+
+    /// The number of allocations made by copying the map
+    size_type copy_allocations() const noexcept {
+        return (empty() ? 0 : 1) + (is_indexed() ? 1 : 0);
+    }
+
+    /// Remove every entry
+    void clear() noexcept {
+        m_entries_.clear();
+        m_table_.clear();
+    }
+
+    /** @brief Reserve room for entries
+     *
+     *  @param n The number of entries to make room for
+     *
+     *  @throw std::bad_alloc if the storage cannot be allocated. Strong throw
+     *         guarantee.
+     */
+    void reserve(size_type n) {
+        m_entries_.reserve(n);
+        if(n >= index_min_size && table_size_for(n) > m_table_.size()) {
+            rehash(table_size_for(n));
+        }
+    }
+
+    /// The entry with key @p key, or end() if there is none
+    iterator find(const key_type& key) {
+        return begin() + static_cast<std::ptrdiff_t>(find_index(id(key)));
+    }
+
+    /// The entry with key @p key, or end() if there is none
+    const_iterator find(const key_type& key) const {
+        return begin() + static_cast<std::ptrdiff_t>(find_index(id(key)));
+    }
+
+    /// The number of entries with key @p key, 0 or 1
+    size_type count(const key_type& key) const {
+        return find_index(id(key)) == size() ? 0 : 1;
+    }
+
+    /** @brief The value mapped to a key
+     *
+     *  @param key The key
+     *
+     *  @return The value mapped to @p key
+     *
+     *  @throw std::out_of_range if there is no entry for @p key. Strong throw
+     *         guarantee.
+     */
+    const mapped_type& at(const key_type& key) const {
+        auto i = find_index(id(key));
+        if(i == size()) throw std::out_of_range("HashMap::at: no such key");
+        return m_entries_[i].second;
+    }
+
+    /** @brief The value mapped to a key, inserting a zero if there is none
+     *
+     *  @param key The key
+     *
+     *  @return The value mapped to @p key
+     *
+     *  @throw std::bad_alloc if the entry cannot be inserted. Strong throw
+     *         guarantee.
+     */
+    mapped_type& operator[](const key_type& key) {
+        const auto key_id = id(key);
+        auto i            = find_index(key_id);
+        if(i == size()) i = insert(key_id, value_type(key, mapped_type{}));
+        return m_entries_[i].second;
+    }
+
+    /** @brief Insert an entry if its key is not present yet
+     *
+     *  @param args Forwarded to the ctor of value_type
+     *
+     *  @return The entry with the key and whether it was inserted
+     *
+     *  @throw std::bad_alloc if the entry cannot be inserted. Strong throw
+     *         guarantee.
+     */
+    template<typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        value_type entry(std::forward<Args>(args)...);
+        const auto key_id = id(entry.first);
+        auto i            = find_index(key_id);
+        const bool added  = i == size();
+        if(added) i = insert(key_id, std::move(entry));
+        return {begin() + static_cast<std::ptrdiff_t>(i), added};
+    }
+
+    /** @brief Insert an entry if its key is not present yet
+     *
+     *  The entries are not ordered, so the hint is ignored.
+     *
+     *  @param args Forwarded to the ctor of value_type
+     *
+     *  @return The entry with the key
+     *
+     *  @throw std::bad_alloc if the entry cannot be inserted. Strong throw
+     *         guarantee.
+     */
+    template<typename... Args>
+    iterator emplace_hint(const_iterator, Args&&... args) {
+        return emplace(std::forward<Args>(args)...).first;
+    }
+
+    /** @brief Add a scaled copy of the entries of another map
+     *
+     *  Each entry of @p other is looked up in the table and either added to
+     *  the existing value or appended, so the cost is proportional to the
+     *  size of @p other only.
+     *
+     *  @param other The entries to add, which may be *this
+     *  @param scale The factor applied to the values of @p other
+     *
+     *  @return The number of entries inserted
+     *
+     *  @throw std::bad_alloc if the storage cannot grow. Basic throw
+     *         guarantee.
+     */
+    template<typename ScaleType>
+    size_type accumulate(const HashMap& other, ScaleType scale) {
+        if(&other == this) {
+            for(auto& entry : m_entries_) entry.second += scale * entry.second;
+            return 0;
+        }
+        // No reserve: an exact one would defeat the geometric growth
+        const auto n_old = size();
+        for(const auto& [key, value] : other) {
+            const auto key_id = id(key);
+            const auto i      = find_index(key_id);
+            if(i == size()) {
+                insert(key_id, value_type(key, scale * value));
+            } else {
+                m_entries_[i].second += scale * value;
+            }
+        }
+        return size() - n_old;
+    }
+
+    /// Whether two maps have the same entries, in any order
+    friend bool operator==(const HashMap& lhs, const HashMap& rhs) {
+        if(lhs.size() != rhs.size()) return false;
+        for(const auto& [key, value] : lhs) {
+            auto it = rhs.find(key);
+            if(it == rhs.end() || !(it->second == value)) return false;
+        }
+        return true;
+    }
+
+    /// Whether two maps have different entries
+    friend bool operator!=(const HashMap& lhs, const HashMap& rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    /// A slot of the hash table
+    struct Bucket {
+        /// The ID of the key, 0 if the slot is free
+        std::uintptr_t id = 0;
+
+        /// The index of the entry with the key
+        size_type index = 0;
+    };
+
+    /// The ID of a key: the address of its cell in units of the cell size
+    static std::uintptr_t id(const key_type& key) {
+        using cell_t = typename key_type::element_type;
+        return reinterpret_cast<std::uintptr_t>(key.get()) / sizeof(cell_t);
+    }
+
+    /// The smallest table size (a power of two) that is at most half full
+    static size_type table_size_for(size_type n) {
+        size_type n_buckets = 2 * index_min_size;
+        while(n_buckets < 2 * n) n_buckets *= 2;
+        return n_buckets;
+    }
+
+    /// The first bucket probed for @p key_id
+    size_type home(std::uintptr_t key_id) const {
+        // Fibonacci hashing spreads consecutive IDs across the table
+        const auto h = static_cast<std::uint64_t>(key_id) *
+                       std::uint64_t{0x9E3779B97F4A7C15};
+        return static_cast<size_type>(h >> 32) & (m_table_.size() - 1);
+    }
+
+    /// The index of the entry whose key has ID @p key_id, or size()
+    size_type find_index(std::uintptr_t key_id) const {
+        if(!is_indexed()) {
+            for(size_type i = 0; i < size(); ++i) {
+                if(id(m_entries_[i].first) == key_id) return i;
+            }
+            return size();
+        }
+        const auto mask = m_table_.size() - 1;
+        for(auto b = home(key_id);; b = (b + 1) & mask) {
+            if(m_table_[b].id == key_id) return m_table_[b].index;
+            if(m_table_[b].id == 0) return size();
+        }
+    }
+
+    /// Record the entry at @p index in the table
+    void index(std::uintptr_t key_id, size_type index) {
+        const auto mask = m_table_.size() - 1;
+        auto b          = home(key_id);
+        while(m_table_[b].id != 0) b = (b + 1) & mask;
+        m_table_[b] = Bucket{key_id, index};
+    }
+
+    /// Rebuild the table with @p n_buckets buckets, leaving it as is on throw
+    void rehash(size_type n_buckets) {
+        std::vector<Bucket> table(n_buckets);
+        m_table_.swap(table);
+        for(size_type i = 0; i < size(); ++i) index(id(m_entries_[i].first), i);
+    }
+
+    /// Append an entry whose key is absent, returning its index
+    size_type insert(std::uintptr_t key_id, value_type entry) {
+        // Grow the table first, so a throw leaves no entry missing from it
+        const auto i       = size();
+        const bool indexed = is_indexed() || i + 1 >= index_min_size;
+        if(indexed && 2 * (i + 1) > m_table_.size()) {
+            rehash(table_size_for(i + 1));
+        }
+        m_entries_.push_back(std::move(entry));
+        if(indexed) index(key_id, i);
+        return i;
+    }
+
+    /// The entries, in insertion order
+    container_type m_entries_;
+
+    /// The hash table, empty while the map is small
+    std::vector<Bucket> m_table_;
+};
+
+} // namespace sigma::detail_
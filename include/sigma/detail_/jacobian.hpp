@@ -0,0 +1,344 @@
+#pragma once
+#include "sigma/detail_/setter.hpp"
+#include "sigma/trace.hpp"
+#include "sigma/uncertain.hpp"
+#include <Eigen/Dense>
+#include <Eigen/SparseCore>
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+/** @file jacobian.hpp
+ *  @brief Conversion between Uncertain values and sparse Jacobians
+ *
+ *  The linear algebra routines work on the mean values with plain floating
+ *  point kernels and propagate the uncertainty through a sparse Jacobian,
+ *  whose rows are the (column-major) elements of a matrix and whose columns
+ *  are the independent variables those elements depend on.
+ */
+
+namespace sigma::detail_ {
+
+/** @brief The independent variables of a set of values, in key order
+ *
+ *  Columns are numbered in the key order of the dependency maps, so building
+ *  a dependency map column by column only ever appends to its end.
+ *
+ *  The index refers to the keys of the values it was built from, which must
+ *  outlive it.
+ *
+ *  @tparam T The value type of the variables
+ */
+template<typename T>
+class DependencyIndex {
+public:
+    /// The type of the uncertain values
+    using uncertain_t = Uncertain<T>;
+
+    /// A pointer to a dependency
+    using dep_sd_ptr = typename uncertain_t::dep_sd_ptr;
+
+    /// The ordering of the dependencies
+    using key_compare = typename uncertain_t::deps_map_t::key_compare;
+
+    /** @brief Add the dependencies of a value
+     *
+     *  @param x The value whose dependencies are added
+     *
+     *  @throw std::bad_alloc if the index cannot grow. Strong throw guarantee.
+     */
+    void add(const uncertain_t& x) {
+        for(const auto& [dep, deriv] : x.deps()) m_vars_.push_back(&dep);
+    }
+
+    /** @brief Add the dependencies of every element of a matrix
+     *
+     *  @tparam Derived The type of the Eigen matrix
+     *  @param m The matrix whose dependencies are added
+     *
+     *  @throw std::bad_alloc if the index cannot grow. Strong throw guarantee.
+     */
+    template<typename Derived>
+    void add(const Eigen::DenseBase<Derived>& m) {
+        for(Eigen::Index j = 0; j < m.cols(); ++j) {
+            for(Eigen::Index i = 0; i < m.rows(); ++i) add(m.derived()(i, j));
+        }
+    }
+
+    /** @brief Add the dependencies of the stored elements of a sparse matrix
+     *
+     *  @tparam Options The storage options of the sparse matrix
+     *  @tparam StorageIndex The index type of the sparse matrix
+     *  @param m The sparse matrix whose dependencies are added
+     *
+     *  @throw std::bad_alloc if the index cannot grow. Strong throw guarantee.
+     */
+    template<int Options, typename StorageIndex>
+    void add(
+      const Eigen::SparseMatrix<uncertain_t, Options, StorageIndex>& m) {
+        using matrix_t =
+          Eigen::SparseMatrix<uncertain_t, Options, StorageIndex>;
+        for(Eigen::Index o = 0; o < m.outerSize(); ++o) {
+            for(typename matrix_t::InnerIterator it(m, o); it; ++it) {
+                add(it.value());
+            }
+        }
+    }
+
+    /** @brief Sort the variables and remove duplicates
+     *
+     *  Must be called after the last add() and before any lookups.
+     *
+     *  @throw none No throw guarantee
+     */
+    void finalize() {
+        key_compare less;
+        auto by_key = [&less](const dep_sd_ptr* a, const dep_sd_ptr* b) {
+            return less(*a, *b);
+        };
+        auto same_key = [&less](const dep_sd_ptr* a, const dep_sd_ptr* b) {
+            return !less(*a, *b) && !less(*b, *a);
+        };
+        std::sort(m_vars_.begin(), m_vars_.end(), by_key);
+        m_vars_.erase(std::unique(m_vars_.begin(), m_vars_.end(), same_key),
+                      m_vars_.end());
+    }
+
+    /// The number of independent variables
+    std::size_t size() const { return m_vars_.size(); }
+
+    /** @brief The column of a dependency
+     *
+     *  @param dep A dependency that was added to the index
+     *
+     *  @return The column of @p dep
+     *
+     *  @throw none No throw guarantee
+     */
+    std::size_t column(const dep_sd_ptr& dep) const {
+        key_compare less;
+        auto it = std::lower_bound(
+          m_vars_.begin(), m_vars_.end(), &dep,
+          [&less](const dep_sd_ptr* a, const dep_sd_ptr* b) {
+              return less(*a, *b);
+          });
+        return static_cast<std::size_t>(it - m_vars_.begin());
+    }
+
+    /// The dependency of column @p c
+    const dep_sd_ptr& variable(std::size_t c) const { return *m_vars_[c]; }
+
+private:
+    /// The dependencies, sorted once finalized
+    std::vector<const dep_sd_ptr*> m_vars_;
+};
+
+/** @brief The total number of dependencies of the elements of a matrix
+ *
+ *  Counts each dependency once per element that has it, as reported by the
+ *  tracing hooks. Elements that are not uncertain count as zero.
+ *
+ *  @tparam Derived The type of the Eigen matrix
+ *  @param m The matrix
+ *
+ *  @return The sum of the dependency counts of the elements of @p m
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename Derived>
+std::size_t total_deps(const Eigen::DenseBase<Derived>& m) {
+    std::size_t n = 0;
+    for(Eigen::Index j = 0; j < m.cols(); ++j) {
+        for(Eigen::Index i = 0; i < m.rows(); ++i) {
+            n += trace_deps(m.derived()(i, j));
+        }
+    }
+    return n;
+}
+
+/** @brief The total number of dependencies of the stored elements of a
+ *         sparse matrix
+ *
+ *  @tparam T The value type of the variables
+ *  @tparam Options The storage options of the sparse matrix
+ *  @tparam StorageIndex The index type of the sparse matrix
+ *  @param m The sparse matrix
+ *
+ *  @return The sum of the dependency counts of the stored elements of @p m
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename T, int Options, typename StorageIndex>
+std::size_t total_deps(
+  const Eigen::SparseMatrix<Uncertain<T>, Options, StorageIndex>& m) {
+    std::size_t n = 0;
+    for(Eigen::Index k = 0; k < m.nonZeros(); ++k) {
+        n += m.valuePtr()[k].deps().size();
+    }
+    return n;
+}
+
+/// The sparse Jacobian type, with one column per independent variable
+template<typename T>
+using jacobian_t = Eigen::SparseMatrix<T, Eigen::ColMajor, Eigen::Index>;
+
+/** @brief The mean values of a matrix of Uncertain values
+ *
+ *  @tparam Derived The type of the Eigen matrix
+ *  @param m The matrix
+ *
+ *  @return A plain matrix with the mean of each element of @p m
+ *
+ *  @throw std::bad_alloc if the result cannot be allocated. Strong throw
+ *         guarantee.
+ */
+template<typename Derived>
+auto mean_matrix(const Eigen::DenseBase<Derived>& m) {
+    using value_t = typename Derived::Scalar::value_t;
+    Eigen::Matrix<value_t, Eigen::Dynamic, Eigen::Dynamic> means(m.rows(),
+                                                                 m.cols());
+    for(Eigen::Index j = 0; j < m.cols(); ++j) {
+        for(Eigen::Index i = 0; i < m.rows(); ++i) {
+            means(i, j) = m.derived()(i, j).mean();
+        }
+    }
+    return means;
+}
+
+/** @brief The mean values of a sparse matrix of Uncertain values
+ *
+ *  @tparam T The value type of the variables
+ *  @tparam Options The storage options of the sparse matrix
+ *  @tparam StorageIndex The index type of the sparse matrix
+ *  @param m The sparse matrix
+ *
+ *  @return A sparse matrix with the same pattern as @p m, holding the mean of
+ *          each stored element
+ *
+ *  @throw std::bad_alloc if the result cannot be allocated. Strong throw
+ *         guarantee.
+ */
+template<typename T, int Options, typename StorageIndex>
+Eigen::SparseMatrix<T, Options, StorageIndex> mean_matrix(
+  const Eigen::SparseMatrix<Uncertain<T>, Options, StorageIndex>& m) {
+    return m.unaryExpr([](const Uncertain<T>& x) { return x.mean(); });
+}
+
+/** @brief Gather the Jacobian of a matrix of Uncertain values
+ *
+ *  @tparam T The value type of the variables
+ *  @tparam Derived The type of the Eigen matrix
+ *  @param m The matrix
+ *  @param index A finalized index containing the dependencies of @p m
+ *
+ *  @return A Jacobian with one row per element of @p m, in column-major
+ *          order, and one column per variable of @p index. Every dependency
+ *          is stored, including those with a zero derivative.
+ *
+ *  @throw std::bad_alloc if the result cannot be allocated. Strong throw
+ *         guarantee.
+ */
+template<typename T, typename Derived>
+jacobian_t<T> gather_jacobian(const Eigen::DenseBase<Derived>& m,
+                              const DependencyIndex<T>& index) {
+    using triplet_t = Eigen::Triplet<T, Eigen::Index>;
+
+    std::vector<triplet_t> triplets;
+    for(Eigen::Index j = 0; j < m.cols(); ++j) {
+        for(Eigen::Index i = 0; i < m.rows(); ++i) {
+            Eigen::Index row = i + j * m.rows();
+            for(const auto& [dep, deriv] : m.derived()(i, j).deps()) {
+                auto col = static_cast<Eigen::Index>(index.column(dep));
+                triplets.emplace_back(row, col, deriv);
+            }
+        }
+    }
+
+    jacobian_t<T> jac(m.size(), static_cast<Eigen::Index>(index.size()));
+    jac.setFromTriplets(triplets.begin(), triplets.end());
+    return jac;
+}
+
+/** @brief Gather the Jacobian of a sparse matrix of Uncertain values
+ *
+ *  @tparam T The value type of the variables
+ *  @tparam Options The storage options of the sparse matrix
+ *  @tparam StorageIndex The index type of the sparse matrix
+ *  @param m The sparse matrix
+ *  @param index A finalized index containing the dependencies of @p m
+ *
+ *  @return A Jacobian laid out as for a dense matrix, in which only the rows
+ *          of the stored elements of @p m have entries
+ *
+ *  @throw std::bad_alloc if the result cannot be allocated. Strong throw
+ *         guarantee.
+ */
+template<typename T, int Options, typename StorageIndex>
+jacobian_t<T> gather_jacobian(
+  const Eigen::SparseMatrix<Uncertain<T>, Options, StorageIndex>& m,
+  const DependencyIndex<T>& index) {
+    using matrix_t  = Eigen::SparseMatrix<Uncertain<T>, Options, StorageIndex>;
+    using triplet_t = Eigen::Triplet<T, Eigen::Index>;
+
+    std::vector<triplet_t> triplets;
+    for(Eigen::Index o = 0; o < m.outerSize(); ++o) {
+        for(typename matrix_t::InnerIterator it(m, o); it; ++it) {
+            Eigen::Index row = it.row() + it.col() * m.rows();
+            for(const auto& [dep, deriv] : it.value().deps()) {
+                auto col = static_cast<Eigen::Index>(index.column(dep));
+                triplets.emplace_back(row, col, deriv);
+            }
+        }
+    }
+
+    jacobian_t<T> jac(m.size(), static_cast<Eigen::Index>(index.size()));
+    jac.setFromTriplets(triplets.begin(), triplets.end());
+    return jac;
+}
+
+/** @brief A matrix of certain values
+ *
+ *  The starting point for assembling results from their means, to which the
+ *  dependencies are then added with the Setter.
+ *
+ *  @tparam Derived The type of the Eigen matrix or expression
+ *  @param means The mean values, evaluated once
+ *
+ *  @return A matrix of Uncertain values without dependencies
+ *
+ *  @throw std::bad_alloc if the result cannot be allocated. Strong throw
+ *         guarantee.
+ */
+template<typename Derived>
+auto certain_matrix(const Eigen::DenseBase<Derived>& means) {
+    using value_t = typename Derived::Scalar;
+    // Evaluate an expression once, e.g. a product, rather than per element
+    const auto& values = means.derived().eval();
+    Eigen::Matrix<Uncertain<value_t>, Eigen::Dynamic, Eigen::Dynamic> m(
+      values.rows(), values.cols());
+    for(Eigen::Index j = 0; j < m.cols(); ++j) {
+        for(Eigen::Index i = 0; i < m.rows(); ++i) {
+            m(i, j) = Uncertain<value_t>(values(i, j));
+        }
+    }
+    return m;
+}
+
+/** @brief Update the standard deviations of a matrix of Uncertain values
+ *
+ *  @tparam Derived The type of the Eigen matrix
+ *  @param m The matrix, whose dependencies are complete
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename Derived>
+void update_sds(Eigen::DenseBase<Derived>& m) {
+    using uncertain_t = typename Derived::Scalar;
+    for(Eigen::Index j = 0; j < m.cols(); ++j) {
+        for(Eigen::Index i = 0; i < m.rows(); ++i) {
+            Setter<uncertain_t>(m.derived()(i, j)).update_sd();
+        }
+    }
+}
+
+} // namespace sigma::detail_
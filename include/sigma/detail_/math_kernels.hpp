@@ -0,0 +1,264 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+/** @file math_kernels.hpp
+ *  @brief Fused value-and-derivative kernels for the operations
+ *
+ *  Each kernel returns the value of a function together with its derivative,
+ *  sharing whatever intermediate results the two have in common. Keeping the
+ *  paired calls (e.g. sin and cos of the same argument) side by side also
+ *  lets the compiler merge them into a single sincos call.
+ */
+
+namespace sigma::detail_::kernels {
+
+/// The value of a unary function and its derivative
+template<typename T>
+using unary_t = std::pair<T, T>;
+
+/// The value of a binary function and its two partial derivatives
+template<typename T>
+using binary_t = std::tuple<T, T, T>;
+
+// -- Trigonometric ------------------------------------------------------------
+
+/// Sine and its derivative
+template<typename T>
+unary_t<T> sin(T x) {
+    T s = std::sin(x);
+    T c = std::cos(x);
+    return {s, c};
+}
+
+/// Cosine and its derivative
+template<typename T>
+unary_t<T> cos(T x) {
+    T s = std::sin(x);
+    T c = std::cos(x);
+    return {c, -s};
+}
+
+/// Tangent and its derivative
+template<typename T>
+unary_t<T> tan(T x) {
+    T t = std::tan(x);
+    return {t, t * t + 1};
+}
+
+/// Arcsine and its derivative
+template<typename T>
+unary_t<T> asin(T x) {
+    return {std::asin(x), 1 / std::sqrt(1 - x * x)};
+}
+
+/// Arccosine and its derivative
+template<typename T>
+unary_t<T> acos(T x) {
+    return {std::acos(x), -1 / std::sqrt(1 - x * x)};
+}
+
+/// Arctangent and its derivative
+template<typename T>
+unary_t<T> atan(T x) {
+    return {std::atan(x), 1 / (1 + x * x)};
+}
+
+/// Two argument arctangent and its partial derivatives
+template<typename T>
+binary_t<T> atan2(T y, T x) {
+    T r2 = x * x + y * y;
+    return {std::atan2(y, x), x / r2, -y / r2};
+}
+
+// -- Hyperbolic ---------------------------------------------------------------
+
+/** @brief Hyperbolic sine and cosine from a single exponential
+ *
+ *  Works on |x| with expm1 so that neither result loses precision near zero,
+ *  then restores the sign of the (odd) sine. exp(|x|) overflows slightly
+ *  before sinh and cosh do, so those are used directly past that point.
+ */
+template<typename T>
+unary_t<T> sinh_cosh(T x) {
+    T em = std::expm1(std::abs(x));
+    if(std::isinf(em)) return {std::sinh(x), std::cosh(x)};
+    T inv_e = 1 / (em + 1);
+    T sh    = em * (1 + inv_e) / 2;
+    T ch    = (em + 1 + inv_e) / 2;
+    return {std::copysign(sh, x), ch};
+}
+
+/// Hyperbolic sine and its derivative
+template<typename T>
+unary_t<T> sinh(T x) {
+    return sinh_cosh(x);
+}
+
+/// Hyperbolic cosine and its derivative
+template<typename T>
+unary_t<T> cosh(T x) {
+    auto [sh, ch] = sinh_cosh(x);
+    return {ch, sh};
+}
+
+/// Hyperbolic tangent and its derivative
+template<typename T>
+unary_t<T> tanh(T x) {
+    T t = std::tanh(x);
+    return {t, 1 - t * t};
+}
+
+/// Inverse hyperbolic sine and its derivative
+template<typename T>
+unary_t<T> asinh(T x) {
+    return {std::asinh(x), 1 / std::sqrt(1 + x * x)};
+}
+
+/// Inverse hyperbolic cosine and its derivative
+template<typename T>
+unary_t<T> acosh(T x) {
+    return {std::acosh(x), 1 / std::sqrt(x * x - 1)};
+}
+
+/// Inverse hyperbolic tangent and its derivative
+template<typename T>
+unary_t<T> atanh(T x) {
+    return {std::atanh(x), 1 / (1 - x * x)};
+}
+
+// -- Exponents and logarithms -------------------------------------------------
+
+/// Power with a constant exponent and its derivative
+template<typename T, typename U>
+unary_t<T> pow(T a, U b) {
+    T p = std::pow(a, b);
+    // p / a reuses the power, but is undefined at the origin
+    T d = (a != 0) ? b * p / a : b * std::pow(a, b - 1);
+    return {p, d};
+}
+
+/// Power and its partial derivatives with respect to base and exponent
+template<typename T>
+binary_t<T> pow_binary(T a, T b) {
+    auto [p, dpda] = pow(a, b);
+    return {p, dpda, std::log(a) * p};
+}
+
+/// Square root and its derivative
+template<typename T>
+unary_t<T> sqrt(T x) {
+    T s = std::sqrt(x);
+    return {s, 1 / (2 * s)};
+}
+
+/// Cube root and its derivative
+template<typename T>
+unary_t<T> cbrt(T x) {
+    T c = std::cbrt(x);
+    return {c, 1 / (3 * c * c)};
+}
+
+/// Exponential and its derivative
+template<typename T>
+unary_t<T> exp(T x) {
+    T e = std::exp(x);
+    return {e, e};
+}
+
+/// Base-2 exponential and its derivative
+template<typename T>
+unary_t<T> exp2(T x) {
+    constexpr double ln2 = 0.69314718055994530942;
+    T e                  = std::exp2(x);
+    return {e, e * T(ln2)};
+}
+
+/// Exponential minus one and its derivative
+template<typename T>
+unary_t<T> expm1(T x) {
+    T em = std::expm1(x);
+    return {em, em + 1};
+}
+
+/// Natural logarithm and its derivative
+template<typename T>
+unary_t<T> log(T x) {
+    return {std::log(x), 1 / x};
+}
+
+/// Base-10 logarithm and its derivative
+template<typename T>
+unary_t<T> log10(T x) {
+    constexpr double ln10 = 2.30258509299404568402;
+    return {std::log10(x), 1 / (x * T(ln10))};
+}
+
+/// Base-2 logarithm and its derivative
+template<typename T>
+unary_t<T> log2(T x) {
+    constexpr double ln2 = 0.69314718055994530942;
+    return {std::log2(x), 1 / (x * T(ln2))};
+}
+
+/// Logarithm of one plus the argument and its derivative
+template<typename T>
+unary_t<T> log1p(T x) {
+    return {std::log1p(x), 1 / (x + 1)};
+}
+
+/// Hypotenuse and its partial derivatives
+template<typename T>
+binary_t<T> hypot(T a, T b) {
+    T h = std::hypot(a, b);
+    return {h, a / h, b / h};
+}
+
+// -- Error function -----------------------------------------------------------
+
+/// Error function and its derivative
+template<typename T>
+unary_t<T> erf(T x) {
+    constexpr double two_over_sqrt_pi = 1.12837916709551257390;
+    return {std::erf(x), std::exp(-x * x) * T(two_over_sqrt_pi)};
+}
+
+/// Complementary error function and its derivative
+template<typename T>
+unary_t<T> erfc(T x) {
+    constexpr double two_over_sqrt_pi = 1.12837916709551257390;
+    return {std::erfc(x), -std::exp(-x * x) * T(two_over_sqrt_pi)};
+}
+
+// -- Batched evaluation -------------------------------------------------------
+
+/** @brief Apply a unary kernel over an array
+ *
+ *  The loop body is a straight-line call to the kernel with no dependencies
+ *  between iterations, so it vectorizes wherever the underlying math library
+ *  provides vector variants of the functions involved (e.g. glibc's libmvec).
+ *
+ *  @tparam KernelType The type of the kernel, a callable taking a single
+ *                     value and returning a unary_t
+ *  @tparam T The floating point type
+ *  @param kernel The kernel to apply
+ *  @param x Pointer to the @p n arguments
+ *  @param values Pointer to storage for the @p n function values
+ *  @param derivs Pointer to storage for the @p n derivatives
+ *  @param n The number of values
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename KernelType, typename T>
+void apply(KernelType&& kernel, const T* x, T* values, T* derivs,
+           std::size_t n) {
+    for(std::size_t i = 0; i < n; ++i) {
+        auto result = kernel(x[i]);
+        values[i]   = result.first;
+        derivs[i]   = result.second;
+    }
+}
+
+} // namespace sigma::detail_::kernels
@@ -1,7 +1,14 @@
 #pragma once
 
 #include "sigma/detail_/setter.hpp"
+#include "sigma/stats.hpp"
+#include "sigma/trace.hpp"
 #include "sigma/uncertain.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
 
 /** @file operation_common.hpp
  *  @brief Common implementation details for operations
@@ -15,15 +22,16 @@ constexpr double pi = 3.14159265358979323846;
 /** @brief Generalized Inplace Unary Changes
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param c The variable being altered
  *  @param mean The new mean value of the variable
  *  @param dcda The partial derivative being added to the chain
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-void inplace_unary(Uncertain<T>& c, T mean, T dcda) {
-    detail_::Setter<Uncertain<T>> c_setter(c);
+template<typename T, typename P>
+void inplace_unary(Uncertain<T, P>& c, T mean, T dcda) {
+    detail_::Setter<Uncertain<T, P>> c_setter(c);
     c_setter.update_mean(mean);
     c_setter.update_derivatives(dcda);
 }
@@ -31,6 +39,7 @@ void inplace_unary(Uncertain<T>& c, T mean, T dcda) {
 /** @brief Generalized Unary Changes
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param a The variable being altered copied
  *  @param mean The new mean value of the variable
  *  @param dcda The partial derivative being added to the chain
@@ -40,9 +49,9 @@ void inplace_unary(Uncertain<T>& c, T mean, T dcda) {
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> unary_result(const Uncertain<T>& a, T mean, T dcda) {
-    Uncertain<T> c(a);
+template<typename T, typename P>
+Uncertain<T, P> unary_result(const Uncertain<T, P>& a, T mean, T dcda) {
+    Uncertain<T, P> c(a);
     detail_::inplace_unary(c, mean, dcda);
     return c;
 }
@@ -50,6 +59,7 @@ Uncertain<T> unary_result(const Uncertain<T>& a, T mean, T dcda) {
 /** @brief Generalized Inplace Binary Changes
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param c The variable being altered
  *  @param b The variable whose dependencies are being added to @p c's
  *  @param mean The new mean value of the variable
@@ -58,10 +68,10 @@ Uncertain<T> unary_result(const Uncertain<T>& a, T mean, T dcda) {
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-void inplace_binary(Uncertain<T>& c, const Uncertain<T>& b, T mean, T dcda,
-                    T dcdb) {
-    detail_::Setter<Uncertain<T>> c_setter(c);
+template<typename T, typename P>
+void inplace_binary(Uncertain<T, P>& c, const Uncertain<T, P>& b, T mean,
+                    T dcda, T dcdb) {
+    detail_::Setter<Uncertain<T, P>> c_setter(c);
     c_setter.update_mean(mean);
     c_setter.update_derivatives(dcda, false);
     c_setter.update_derivatives(b.deps(), dcdb);
@@ -70,6 +80,7 @@ void inplace_binary(Uncertain<T>& c, const Uncertain<T>& b, T mean, T dcda,
 /** @brief Generalized Binary Changes
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param a The variable being altered copied
  *  @param b The variable whose dependencies are being added to @p a's
  *  @param mean The new mean value of the variable
@@ -81,14 +92,157 @@ void inplace_binary(Uncertain<T>& c, const Uncertain<T>& b, T mean, T dcda,
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> binary_result(const Uncertain<T>& a, const Uncertain<T>& b, T mean,
-                           T dcda, T dcdb) {
-    Uncertain<T> c(a);
+template<typename T, typename P>
+Uncertain<T, P> binary_result(const Uncertain<T, P>& a,
+                              const Uncertain<T, P>& b, T mean, T dcda,
+                              T dcdb) {
+    Uncertain<T, P> c(a);
     detail_::inplace_binary(c, b, mean, dcda, dcdb);
     return c;
 }
 
+/** @brief Merged index of the dependencies of several variables
+ *
+ *  Each entry holds a dependency together with the partial derivative of
+ *  every input with respect to it (zero if the input does not depend on it).
+ *  Entries are in the key order of the dependency maps.
+ *
+ *  @tparam T The value type of the variables
+ *  @tparam N The number of inputs
+ */
+template<typename T, std::size_t N>
+using merged_deps_t =
+  std::vector<std::pair<typename Uncertain<T>::dep_sd_ptr, std::array<T, N>>>;
+
+/** @brief Merge the dependencies of several variables into one index
+ *
+ *  @tparam T The value type of the variables
+ *  @tparam P The propagation policy of the variables
+ *  @tparam N The number of inputs
+ *  @param inputs The variables whose dependencies are merged
+ *
+ *  @return The merged index of the dependencies of @p inputs
+ *
+ *  @throw std::bad_alloc if the index cannot be allocated. Strong throw
+ *         guarantee.
+ */
+template<typename T, typename P, std::size_t N>
+merged_deps_t<T, N> merge_deps(
+  const std::array<const Uncertain<T, P>*, N>& inputs) {
+    using deps_map_t = typename Uncertain<T, P>::deps_map_t;
+    using iterator_t = typename deps_map_t::const_iterator;
+    typename deps_map_t::key_compare less;
+
+    std::size_t max_size = 0;
+    std::array<iterator_t, N> its, ends;
+    for(std::size_t i = 0; i < N; ++i) {
+        its[i]  = inputs[i]->deps().begin();
+        ends[i] = inputs[i]->deps().end();
+        max_size += inputs[i]->deps().size();
+    }
+
+    detail_::count_merge(max_size);
+    detail_::count_allocations(1);
+
+    merged_deps_t<T, N> merged;
+    merged.reserve(max_size);
+    if constexpr(!is_ordered_v<deps_map_t>) {
+        // Sort the keys of every input, then look each one up in each input
+        using key_ptr = const typename Uncertain<T, P>::dep_sd_ptr*;
+        std::vector<key_ptr> keys;
+        keys.reserve(max_size);
+        for(const auto* input : inputs) {
+            for(const auto& [dep, deriv] : input->deps()) keys.push_back(&dep);
+        }
+        auto by_key = [&less](key_ptr a, key_ptr b) {
+            return less(*a, *b);
+        };
+        auto same_key = [&less](key_ptr a, key_ptr b) {
+            return !less(*a, *b) && !less(*b, *a);
+        };
+        std::sort(keys.begin(), keys.end(), by_key);
+        keys.erase(std::unique(keys.begin(), keys.end(), same_key), keys.end());
+        for(auto key : keys) {
+            std::array<T, N> derivs{};
+            for(std::size_t i = 0; i < N; ++i) {
+                auto it = inputs[i]->deps().find(*key);
+                if(it != ends[i]) derivs[i] = it->second;
+            }
+            merged.emplace_back(*key, derivs);
+        }
+        return merged;
+    }
+    while(true) {
+        // Find the smallest key that has not been merged yet
+        const typename Uncertain<T, P>::dep_sd_ptr* key = nullptr;
+        for(std::size_t i = 0; i < N; ++i) {
+            if(its[i] == ends[i]) continue;
+            if(key == nullptr || less(its[i]->first, *key)) {
+                key = &its[i]->first;
+            }
+        }
+        if(key == nullptr) break;
+
+        std::array<T, N> derivs{};
+        auto dep = *key;
+        for(std::size_t i = 0; i < N; ++i) {
+            if(its[i] == ends[i] || less(dep, its[i]->first)) continue;
+            derivs[i] = its[i]->second;
+            ++its[i];
+        }
+        merged.emplace_back(std::move(dep), derivs);
+    }
+    return merged;
+}
+
+/** @brief Generalized Changes for Several Outputs of the Same Inputs
+ *
+ *  The dependencies of the inputs are merged once and the resulting index is
+ *  reused to build every output, so functions with several correlated
+ *  results avoid repeating the merge per output.
+ *
+ *  @tparam T The value type of the variables
+ *  @tparam P The propagation policy of the variables
+ *  @tparam M The number of outputs
+ *  @tparam N The number of inputs
+ *  @param inputs The variables the outputs depend on
+ *  @param means The mean values of the outputs
+ *  @param partials The partial derivative of each output (first index) with
+ *                  respect to each input (second index)
+ *
+ *  @return The outputs, with the dependencies of @p inputs propagated
+ *
+ *  @throw std::bad_alloc if the outputs cannot be allocated. Strong throw
+ *         guarantee.
+ */
+template<typename T, typename P, std::size_t M, std::size_t N>
+std::array<Uncertain<T, P>, M> multi_result(
+  const std::array<const Uncertain<T, P>*, N>& inputs,
+  const std::array<T, M>& means,
+  const std::array<std::array<T, N>, M>& partials) {
+    std::array<Uncertain<T, P>, M> outputs;
+    if constexpr(!P::propagates) {
+        // No dependencies to merge
+        for(std::size_t o = 0; o < M; ++o) outputs[o] = means[o];
+        return outputs;
+    } else {
+        auto merged = merge_deps(inputs);
+        for(std::size_t o = 0; o < M; ++o) {
+            detail_::Setter<Uncertain<T, P>> setter(outputs[o]);
+            setter.update_mean(means[o]);
+            for(const auto& [dep, derivs] : merged) {
+                T deriv = 0;
+                for(std::size_t i = 0; i < N; ++i) {
+                    deriv += partials[o][i] * derivs[i];
+                }
+                setter.add_dependency(dep, deriv);
+            }
+            setter.update_sd();
+        }
+        return outputs;
+    }
+}
+
 /** @brief Compute the numeric derivative of a function
  *
  *  @tparam FunctionType The type of the function @p f
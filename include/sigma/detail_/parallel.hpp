@@ -0,0 +1,53 @@
+#pragma once
+#include <utility>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/** @file parallel.hpp
+ *  @brief Optional OpenMP parallelism
+ *
+ *  Everything here compiles to its serial equivalent when OpenMP is not
+ *  enabled.
+ */
+
+/** @def SIGMA_OMP(directive)
+ *  @brief Applies an OpenMP directive, if OpenMP is enabled
+ *
+ *  Used instead of a bare `#pragma omp` so that builds without OpenMP do not
+ *  warn about unknown pragmas.
+ */
+#ifdef _OPENMP
+#define SIGMA_PRAGMA(x) _Pragma(#x)
+#define SIGMA_OMP(directive) SIGMA_PRAGMA(omp directive)
+#else
+#define SIGMA_OMP(directive)
+#endif
+
+namespace sigma::detail_ {
+
+/** @brief The share of a range of work of the calling thread
+ *
+ *  Splits [0, n) into contiguous, nearly equal blocks, one per thread of the
+ *  enclosing parallel region. Outside of a parallel region the calling
+ *  thread gets the whole range.
+ *
+ *  @tparam IndexType The integral type of the indices
+ *  @param n The size of the range
+ *
+ *  @return The first index and one past the last index for this thread
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename IndexType>
+std::pair<IndexType, IndexType> thread_range(IndexType n) {
+#ifdef _OPENMP
+    const auto n_threads = static_cast<IndexType>(omp_get_num_threads());
+    const auto thread    = static_cast<IndexType>(omp_get_thread_num());
+    return {n * thread / n_threads, n * (thread + 1) / n_threads};
+#else
+    return {IndexType{0}, n};
+#endif
+}
+
+} // namespace sigma::detail_
@@ -1,5 +1,12 @@
 #pragma once
+#include "sigma/detail_/adaptive_map.hpp"
+#include "sigma/detail_/flat_map.hpp"
+#include "sigma/detail_/hash_map.hpp"
+#include "sigma/stats.hpp"
 #include "sigma/uncertain.hpp"
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
 
 /** @file setter.hpp 
  *  @brief Defines the Setter class
@@ -7,6 +14,166 @@
 
 namespace sigma::detail_ {
 
+/** @brief Whether a dependency container iterates in key order
+ *
+ *  Code that walks the dependencies of several variables side by side, like
+ *  merge_deps, relies on the order; it sorts the keys first for containers
+ *  that do not keep it.
+ *
+ *  @tparam MapType The type of the dependency container
+ */
+template<typename MapType>
+struct is_ordered : std::true_type {};
+
+/// HashMap iterates in insertion order
+template<typename K, typename V>
+struct is_ordered<HashMap<K, V>> : std::false_type {};
+
+/// Whether a dependency container iterates in key order
+template<typename MapType>
+inline constexpr bool is_ordered_v = is_ordered<MapType>::value;
+
+/** @brief Add scaled dependencies to those of a variable
+ *
+ *  The generic version for any container with the std::map interface,
+ *  looking up each entry of @p from in @p to.
+ *
+ *  @tparam MapType The type of the dependency container
+ *  @tparam T The value type of the variable
+ *  @param to The dependencies being updated
+ *  @param from The dependencies to add, which may be @p to
+ *  @param scale The factor applied to the derivatives of @p from
+ *
+ *  @return The number of dependencies added to @p to
+ *
+ *  @throw std::bad_alloc if an entry cannot be inserted. Basic throw
+ *         guarantee.
+ */
+template<typename MapType, typename T>
+std::size_t accumulate_deps(MapType& to, const MapType& from, T scale) {
+    std::size_t n_added = 0;
+    for(const auto& [dep, deriv] : from) {
+        auto new_deriv = scale * deriv;
+        auto it        = to.find(dep);
+        if(it != to.end()) {
+            it->second += new_deriv;
+        } else {
+            to.emplace(dep, new_deriv);
+            ++n_added;
+        }
+    }
+    return n_added;
+}
+
+/** @brief Add scaled dependencies to those of a variable
+ *
+ *  The version for FlatMap, merging the two sorted sets in one pass.
+ *
+ *  @tparam K The type of the dependencies
+ *  @tparam V The type of the derivatives
+ *  @tparam T The value type of the variable
+ *  @param to The dependencies being updated
+ *  @param from The dependencies to add, which may be @p to
+ *  @param scale The factor applied to the derivatives of @p from
+ *
+ *  @return The number of dependencies added to @p to
+ *
+ *  @throw std::bad_alloc if the storage cannot grow. Strong throw guarantee.
+ */
+template<typename K, typename V, typename T>
+std::size_t accumulate_deps(FlatMap<K, V>& to, const FlatMap<K, V>& from,
+                            T scale) {
+    return to.accumulate(from, scale);
+}
+
+/** @brief Add scaled dependencies to those of a variable
+ *
+ *  The version for AdaptiveMap, specialized on the layouts of both maps.
+ *
+ *  @tparam K The type of the dependencies
+ *  @tparam V The type of the derivatives
+ *  @tparam T The value type of the variable
+ *  @param to The dependencies being updated
+ *  @param from The dependencies to add, which may be @p to
+ *  @param scale The factor applied to the derivatives of @p from
+ *
+ *  @return The number of dependencies added to @p to
+ *
+ *  @throw std::bad_alloc if the storage cannot grow. Strong throw guarantee.
+ */
+template<typename K, typename V, typename T>
+std::size_t accumulate_deps(AdaptiveMap<K, V>& to,
+                            const AdaptiveMap<K, V>& from, T scale) {
+    return to.accumulate(from, scale);
+}
+
+/** @brief Add scaled dependencies to those of a variable
+ *
+ *  The version for HashMap, which costs one lookup per entry of @p from,
+ *  independently of the size of @p to.
+ *
+ *  @tparam K The type of the dependencies
+ *  @tparam V The type of the derivatives
+ *  @tparam T The value type of the variable
+ *  @param to The dependencies being updated
+ *  @param from The dependencies to add, which may be @p to
+ *  @param scale The factor applied to the derivatives of @p from
+ *
+ *  @return The number of dependencies added to @p to
+ *
+ *  @throw std::bad_alloc if the storage cannot grow. Basic throw guarantee.
+ */
+template<typename K, typename V, typename T>
+std::size_t accumulate_deps(HashMap<K, V>& to, const HashMap<K, V>& from,
+                            T scale) {
+    return to.accumulate(from, scale);
+}
+
+/** @brief Multiply every derivative of a variable by a factor
+ *
+ *  @tparam MapType The type of the dependency container
+ *  @tparam T The value type of the variable
+ *  @param deps The dependencies
+ *  @param scale The factor
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename MapType, typename T>
+void scale_deps(MapType& deps, T scale) {
+    for(auto& [dep, deriv] : deps) deriv *= scale;
+}
+
+/// The version for AdaptiveMap, which scales the dense layout without branches
+template<typename K, typename V, typename T>
+void scale_deps(AdaptiveMap<K, V>& deps, T scale) {
+    deps.scale(scale);
+}
+
+/** @brief The variance of a variable from its dependencies
+ *
+ *  @tparam MapType The type of the dependency container
+ *  @param deps The dependencies
+ *
+ *  @return The sum over the dependencies of (sd * derivative)^2
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename MapType>
+typename MapType::mapped_type variance(const MapType& deps) {
+    typename MapType::mapped_type var = 0.0;
+    for(const auto& [dep, deriv] : deps) {
+        if(deriv == 0.0) continue;
+        var += std::pow(*dep.get() * deriv, 2.0);
+    }
+    return var;
+}
+
+/// The version for AdaptiveMap, which walks the bitmap of the dense layout
+template<typename K, typename V>
+V variance(const AdaptiveMap<K, V>& deps) {
+    return deps.sum_of_squares();
+}
+
 /** @brief Modifies an unceratin variable.
  *
  *  This class provides a handle for operations to modify the private members
@@ -58,12 +225,8 @@ public:
      *  @throw none No throw guarantee
      */
     void update_sd() {
-        m_x_.m_sd_ = 0.0;
-        for(const auto& [dep, deriv] : m_x_.m_deps_) {
-            if(deriv == 0.0) continue;
-            m_x_.m_sd_ += std::pow(*dep.get() * deriv, 2.0);
-        }
-        m_x_.m_sd_ = std::sqrt(m_x_.m_sd_);
+        detail_::count_sd_update(m_x_.m_deps_.size());
+        m_x_.m_sd_ = std::sqrt(detail_::variance(m_x_.m_deps_));
     }
 
     /** @brief Update of existing derivatives
@@ -78,9 +241,8 @@ public:
      */
     void update_derivatives(value_t dxda, bool call_update_std = true) {
         if(dxda != 1.0) {
-            for(const auto& [dep, deriv] : m_x_.m_deps_) {
-                m_x_.m_deps_[dep] *= dxda;
-            }
+            detail_::count_entries(m_x_.m_deps_.size());
+            detail_::scale_deps(m_x_.m_deps_, dxda);
         }
         if(call_update_std) update_sd();
     }
@@ -99,17 +261,90 @@ public:
      */
     void update_derivatives(const deps_map_t& deps, value_t dxda,
                             bool call_update_std = true) {
-        for(const auto& [dep, deriv] : deps) {
-            auto new_deriv = dxda * deriv;
-            if(m_x_.m_deps_.count(dep) != 0) {
-                m_x_.m_deps_[dep] += new_deriv;
-            } else {
-                m_x_.m_deps_.emplace(std::make_pair(std::move(dep), new_deriv));
-            }
-        }
+        auto n_added = detail_::accumulate_deps(m_x_.m_deps_, deps, dxda);
+        detail_::count_merge(deps.size());
+        detail_::count_allocations(n_added);
+        detail_::count_deps_size(m_x_.m_deps_.size());
         if(call_update_std) update_sd();
     }
 
+    /** @brief Add a dependency that is not yet tracked by the variable
+     *
+     *  Dependencies are expected to arrive in key order, so the end of the
+     *  map is used as the insertion hint. Out-of-order additions are still
+     *  placed correctly, just without the benefit of the hint.
+     *
+     *  @param dep The dependency to add
+     *  @param dxda The partial derivative of this variable with respect to
+     *              the dependency
+     *
+     *  @throw std::bad_alloc if the map node cannot be allocated. Strong throw
+     *         guarantee.
+     */
+    void add_dependency(dep_sd_ptr dep, value_t dxda) {
+        m_x_.m_deps_.emplace_hint(m_x_.m_deps_.end(), std::move(dep), dxda);
+        detail_::count_allocations(1);
+        detail_::count_deps_size(m_x_.m_deps_.size());
+    }
+
+private:
+    /// The variable being modified
+    uncertain_t& m_x_;
+};
+
+/** @brief Modifies a variable that only computes its mean
+ *
+ *  Only the mean is stored, so updates of the dependencies and standard
+ *  deviation do nothing and compile away.
+ *
+ *  @tparam T The value type of the variable
+ */
+template<typename T>
+class Setter<Uncertain<T, NoPropagation>> {
+public:
+    /// Type of the instance
+    using my_t = Setter<Uncertain<T, NoPropagation>>;
+
+    /// The numeric type of the variable
+    using uncertain_t = Uncertain<T, NoPropagation>;
+
+    /// The type of the values of the variable
+    using value_t = typename uncertain_t::value_t;
+
+    /// A pointer to a dependency of this variable
+    using dep_sd_ptr = typename uncertain_t::dep_sd_ptr;
+
+    /// The type of the map holding the variable's dependencies
+    using deps_map_t = typename uncertain_t::deps_map_t;
+
+    /** @brief Construct a Setter for a variable
+     *
+     *  @param u The variable *this will modify.
+     *
+     *  @throw none No throw guarantee
+     */
+    Setter(uncertain_t& u) : m_x_(u) {}
+
+    /** @brief Update the mean of the wrapped variable
+     *
+     *  @param mean The new mean value of the variable
+     *
+     *  @throw none No throw guarantee
+     */
+    void update_mean(value_t mean) { m_x_.m_mean_ = mean; }
+
+    /// Does nothing, the standard deviation is always zero
+    void update_sd() {}
+
+    /// Does nothing, there are no dependencies
+    void update_derivatives(value_t, bool = true) {}
+
+    /// Does nothing, there are no dependencies
+    void update_derivatives(const deps_map_t&, value_t, bool = true) {}
+
+    /// Does nothing, there are no dependencies
+    void add_dependency(dep_sd_ptr, value_t) {}
+
 private:
     /// The variable being modified
     uncertain_t& m_x_;
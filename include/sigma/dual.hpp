@@ -0,0 +1,353 @@
+#pragma once
+#include "sigma/detail_/math_kernels.hpp"
+#include "sigma/detail_/special_functions.hpp"
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+/** @file dual.hpp
+ *  @brief Defines the Dual class used for forward-mode differentiation
+ */
+
+namespace sigma {
+
+/** @brief A value paired with its gradient with respect to N inputs
+ *
+ *  Dual numbers carry the exact partial derivatives of a value through a
+ *  computation, which is how sigma::lift obtains the derivatives of a user
+ *  function from a single evaluation. The math functions below are found by
+ *  argument-dependent lookup, so generic code should call them unqualified
+ *  (e.g. `using std::sin; sin(x)`) or through the `sigma` namespace.
+ *
+ *  @tparam ValueType The type of the value and the partial derivatives
+ *  @tparam N The number of inputs being differentiated against
+ */
+template<typename ValueType, std::size_t N>
+class Dual {
+public:
+    /// Type of the instance
+    using my_t = Dual<ValueType, N>;
+
+    /// The numeric type of the value
+    using value_t = ValueType;
+
+    /// The type holding the partial derivatives
+    using gradient_t = std::array<value_t, N>;
+
+    /** @brief Construct a constant
+     *
+     *  @param value The value of the constant
+     *
+     *  @throw none No throw guarantee
+     */
+    Dual(value_t value = 0) : m_value_(value), m_gradient_{} {}
+
+    /** @brief Construct from a value and its gradient
+     *
+     *  @param value The value
+     *  @param gradient The partial derivatives of the value
+     *
+     *  @throw none No throw guarantee
+     */
+    Dual(value_t value, const gradient_t& gradient) :
+      m_value_(value), m_gradient_(gradient) {}
+
+    /** @brief Create the i-th input variable
+     *
+     *  @param value The value of the input
+     *  @param i The index of the input
+     *
+     *  @return A Dual with a unit derivative with respect to input @p i
+     *
+     *  @throw none No throw guarantee
+     */
+    static my_t variable(value_t value, std::size_t i) {
+        my_t x(value);
+        x.m_gradient_[i] = 1;
+        return x;
+    }
+
+    /// The value
+    value_t value() const { return m_value_; }
+
+    /// The partial derivatives of the value
+    const gradient_t& gradient() const { return m_gradient_; }
+
+    /// The partial derivative with respect to input @p i
+    value_t derivative(std::size_t i) const { return m_gradient_[i]; }
+
+    /** @brief Apply the chain rule for an outer function
+     *
+     *  @param value The value of the outer function
+     *  @param dfdx The derivative of the outer function at value()
+     *
+     *  @return A Dual with the value @p value and gradient scaled by @p dfdx
+     *
+     *  @throw none No throw guarantee
+     */
+    my_t chain(value_t value, value_t dfdx) const {
+        my_t c(value);
+        for(std::size_t i = 0; i < N; ++i) {
+            c.m_gradient_[i] = dfdx * m_gradient_[i];
+        }
+        return c;
+    }
+
+    /** @brief Apply the chain rule for an outer function of two Duals
+     *
+     *  @param b The second argument of the outer function
+     *  @param value The value of the outer function
+     *  @param dfda The partial derivative with respect to *this
+     *  @param dfdb The partial derivative with respect to @p b
+     *
+     *  @return A Dual with the value @p value and the combined gradient
+     *
+     *  @throw none No throw guarantee
+     */
+    my_t chain(const my_t& b, value_t value, value_t dfda,
+               value_t dfdb) const {
+        my_t c(value);
+        for(std::size_t i = 0; i < N; ++i) {
+            c.m_gradient_[i] =
+              dfda * m_gradient_[i] + dfdb * b.m_gradient_[i];
+        }
+        return c;
+    }
+
+    /// Inplace addition
+    my_t& operator+=(const my_t& rhs) {
+        *this = chain(rhs, m_value_ + rhs.m_value_, 1, 1);
+        return *this;
+    }
+    /// Inplace subtraction
+    my_t& operator-=(const my_t& rhs) {
+        *this = chain(rhs, m_value_ - rhs.m_value_, 1, -1);
+        return *this;
+    }
+    /// Inplace multiplication
+    my_t& operator*=(const my_t& rhs) {
+        *this = chain(rhs, m_value_ * rhs.m_value_, rhs.m_value_, m_value_);
+        return *this;
+    }
+    /// Inplace division
+    my_t& operator/=(const my_t& rhs) {
+        value_t inv = 1 / rhs.m_value_;
+        *this = chain(rhs, m_value_ * inv, inv, -m_value_ * inv * inv);
+        return *this;
+    }
+
+private:
+    /// The value
+    value_t m_value_;
+
+    /// The partial derivatives of the value
+    gradient_t m_gradient_;
+};
+
+namespace detail_ {
+
+/// Whether @p U is a scalar that can be mixed with Dual values
+template<typename U>
+constexpr bool is_dual_scalar_v = std::is_arithmetic_v<U>;
+
+} // namespace detail_
+
+// -- Arithmetic ---------------------------------------------------------------
+
+/** @relates Dual
+ *  @brief Unary plus
+ */
+template<typename T, std::size_t N>
+Dual<T, N> operator+(const Dual<T, N>& a) {
+    return a;
+}
+/** @relates Dual */
+template<typename T, std::size_t N>
+Dual<T, N> operator-(const Dual<T, N>& a) {
+    return a.chain(-a.value(), -1);
+}
+/** @relates Dual */
+template<typename T, std::size_t N>
+Dual<T, N> operator+(Dual<T, N> a, const Dual<T, N>& b) {
+    return a += b;
+}
+/** @relates Dual */
+template<typename T, std::size_t N>
+Dual<T, N> operator-(Dual<T, N> a, const Dual<T, N>& b) {
+    return a -= b;
+}
+/** @relates Dual */
+template<typename T, std::size_t N>
+Dual<T, N> operator*(Dual<T, N> a, const Dual<T, N>& b) {
+    return a *= b;
+}
+/** @relates Dual */
+template<typename T, std::size_t N>
+Dual<T, N> operator/(Dual<T, N> a, const Dual<T, N>& b) {
+    return a /= b;
+}
+
+/** @def SIGMA_DUAL_SCALAR_OPERATOR(op)
+ *  @brief Factorization of the mixed Dual/scalar arithmetic operators
+ *
+ *  Scalars are treated as constants, i.e. with a zero gradient.
+ */
+#define SIGMA_DUAL_SCALAR_OPERATOR(op)                                  \
+    /** @relates Dual */                                                \
+    template<typename T, std::size_t N, typename U,                     \
+             typename = std::enable_if_t<detail_::is_dual_scalar_v<U>>> \
+    Dual<T, N> operator op(const Dual<T, N>& a, U b) {                  \
+        return a op Dual<T, N>(T(b));                                   \
+    }                                                                   \
+    /** @relates Dual */                                                \
+    template<typename T, std::size_t N, typename U,                     \
+             typename = std::enable_if_t<detail_::is_dual_scalar_v<U>>> \
+    Dual<T, N> operator op(U a, const Dual<T, N>& b) {                  \
+        return Dual<T, N>(T(a)) op b;                                   \
+    }                                                                   \
+    /** @relates Dual */                                                \
+    template<typename T, std::size_t N, typename U,                     \
+             typename = std::enable_if_t<detail_::is_dual_scalar_v<U>>> \
+    Dual<T, N>& operator op##=(Dual<T, N>& a, U b) {                    \
+        return a op##= Dual<T, N>(T(b));                                \
+    }
+
+SIGMA_DUAL_SCALAR_OPERATOR(+)
+SIGMA_DUAL_SCALAR_OPERATOR(-)
+SIGMA_DUAL_SCALAR_OPERATOR(*)
+SIGMA_DUAL_SCALAR_OPERATOR(/)
+
+#undef SIGMA_DUAL_SCALAR_OPERATOR
+
+// -- Comparisons --------------------------------------------------------------
+
+/** @def SIGMA_DUAL_COMPARISON(op)
+ *  @brief Factorization of the comparison operators
+ *
+ *  Comparisons only consider the values, which allows user functions to
+ *  branch on their inputs.
+ */
+#define SIGMA_DUAL_COMPARISON(op)                                       \
+    /** @relates Dual */                                                \
+    template<typename T, std::size_t N>                                 \
+    bool operator op(const Dual<T, N>& a, const Dual<T, N>& b) {        \
+        return a.value() op b.value();                                  \
+    }                                                                   \
+    /** @relates Dual */                                                \
+    template<typename T, std::size_t N, typename U,                     \
+             typename = std::enable_if_t<detail_::is_dual_scalar_v<U>>> \
+    bool operator op(const Dual<T, N>& a, U b) {                        \
+        return a.value() op b;                                          \
+    }                                                                   \
+    /** @relates Dual */                                                \
+    template<typename T, std::size_t N, typename U,                     \
+             typename = std::enable_if_t<detail_::is_dual_scalar_v<U>>> \
+    bool operator op(U a, const Dual<T, N>& b) {                        \
+        return a op b.value();                                          \
+    }
+
+SIGMA_DUAL_COMPARISON(==)
+SIGMA_DUAL_COMPARISON(!=)
+SIGMA_DUAL_COMPARISON(<)
+SIGMA_DUAL_COMPARISON(>)
+SIGMA_DUAL_COMPARISON(<=)
+SIGMA_DUAL_COMPARISON(>=)
+
+#undef SIGMA_DUAL_COMPARISON
+
+// -- Math functions -----------------------------------------------------------
+
+/** @def SIGMA_DUAL_UNARY_FUNCTION(name)
+ *  @brief Factorization of unary math functions in terms of their kernels
+ */
+#define SIGMA_DUAL_UNARY_FUNCTION(name)                               \
+    /** @relates Dual */                                              \
+    template<typename T, std::size_t N>                               \
+    Dual<T, N> name(const Dual<T, N>& a) {                            \
+        auto [value, dfdx] = detail_::kernels::name(a.value());       \
+        return a.chain(value, dfdx);                                  \
+    }
+
+SIGMA_DUAL_UNARY_FUNCTION(sin)
+SIGMA_DUAL_UNARY_FUNCTION(cos)
+SIGMA_DUAL_UNARY_FUNCTION(tan)
+SIGMA_DUAL_UNARY_FUNCTION(asin)
+SIGMA_DUAL_UNARY_FUNCTION(acos)
+SIGMA_DUAL_UNARY_FUNCTION(atan)
+SIGMA_DUAL_UNARY_FUNCTION(sinh)
+SIGMA_DUAL_UNARY_FUNCTION(cosh)
+SIGMA_DUAL_UNARY_FUNCTION(tanh)
+SIGMA_DUAL_UNARY_FUNCTION(asinh)
+SIGMA_DUAL_UNARY_FUNCTION(acosh)
+SIGMA_DUAL_UNARY_FUNCTION(atanh)
+SIGMA_DUAL_UNARY_FUNCTION(sqrt)
+SIGMA_DUAL_UNARY_FUNCTION(cbrt)
+SIGMA_DUAL_UNARY_FUNCTION(exp)
+SIGMA_DUAL_UNARY_FUNCTION(exp2)
+SIGMA_DUAL_UNARY_FUNCTION(expm1)
+SIGMA_DUAL_UNARY_FUNCTION(log)
+SIGMA_DUAL_UNARY_FUNCTION(log10)
+SIGMA_DUAL_UNARY_FUNCTION(log2)
+SIGMA_DUAL_UNARY_FUNCTION(log1p)
+SIGMA_DUAL_UNARY_FUNCTION(erf)
+SIGMA_DUAL_UNARY_FUNCTION(erfc)
+
+#undef SIGMA_DUAL_UNARY_FUNCTION
+
+/** @relates Dual */
+template<typename T, std::size_t N>
+Dual<T, N> abs(const Dual<T, N>& a) {
+    return a.chain(std::abs(a.value()), (a.value() >= 0) ? 1 : -1);
+}
+/** @relates Dual */
+template<typename T, std::size_t N>
+Dual<T, N> fabs(const Dual<T, N>& a) {
+    return abs(a);
+}
+/** @relates Dual */
+template<typename T, std::size_t N>
+Dual<T, N> tgamma(const Dual<T, N>& a) {
+    T value = std::tgamma(a.value());
+    return a.chain(value, value * detail_::digamma(a.value()));
+}
+/** @relates Dual */
+template<typename T, std::size_t N>
+Dual<T, N> lgamma(const Dual<T, N>& a) {
+    return a.chain(std::lgamma(a.value()), detail_::digamma(a.value()));
+}
+/** @relates Dual */
+template<typename T, std::size_t N, typename U,
+         typename = std::enable_if_t<detail_::is_dual_scalar_v<U>>>
+Dual<T, N> pow(const Dual<T, N>& a, U b) {
+    auto [value, dfda] = detail_::kernels::pow(a.value(), T(b));
+    return a.chain(value, dfda);
+}
+/** @relates Dual */
+template<typename T, std::size_t N, typename U,
+         typename = std::enable_if_t<detail_::is_dual_scalar_v<U>>>
+Dual<T, N> pow(U a, const Dual<T, N>& b) {
+    T value = std::pow(T(a), b.value());
+    return b.chain(value, std::log(T(a)) * value);
+}
+/** @relates Dual */
+template<typename T, std::size_t N>
+Dual<T, N> pow(const Dual<T, N>& a, const Dual<T, N>& b) {
+    auto [value, dfda, dfdb] =
+      detail_::kernels::pow_binary(a.value(), b.value());
+    return a.chain(b, value, dfda, dfdb);
+}
+/** @relates Dual */
+template<typename T, std::size_t N>
+Dual<T, N> atan2(const Dual<T, N>& y, const Dual<T, N>& x) {
+    auto [value, dfdy, dfdx] = detail_::kernels::atan2(y.value(), x.value());
+    return y.chain(x, value, dfdy, dfdx);
+}
+/** @relates Dual */
+template<typename T, std::size_t N>
+Dual<T, N> hypot(const Dual<T, N>& a, const Dual<T, N>& b) {
+    auto [value, dfda, dfdb] = detail_::kernels::hypot(a.value(), b.value());
+    return a.chain(b, value, dfda, dfdb);
+}
+
+} // namespace sigma
@@ -0,0 +1,117 @@
+#pragma once
+#include "sigma/detail_/jacobian.hpp"
+#include "sigma/detail_/parallel.hpp"
+#include "sigma/trace.hpp"
+#include "sigma/uncertain.hpp"
+#include <Eigen/Dense>
+#include <cstddef>
+
+/** @file covariance.hpp
+ *  @brief Covariances between Uncertain values
+ */
+
+namespace sigma {
+namespace detail_ {
+
+/** @brief Accumulate a block of columns of J J^T
+ *
+ *  Each independent variable adds the outer product of its column of @p jac
+ *  with itself, so only pairs of elements sharing a variable are visited.
+ *  Only the elements of columns [@p first, @p last) of @p cov are written, so
+ *  blocks that do not overlap can be computed concurrently.
+ *
+ *  @tparam T The value type of the variables
+ *  @param jac The Jacobian, with its columns scaled by the standard
+ *             deviations of the variables
+ *  @param first The first column of the block
+ *  @param last One past the last column of the block
+ *  @param cov The covariance matrix, zero in the block on entry
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename T>
+void covariance_columns(const jacobian_t<T>& jac, Eigen::Index first,
+                        Eigen::Index last,
+                        Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& cov) {
+    using iterator_t = typename jacobian_t<T>::InnerIterator;
+
+    for(Eigen::Index v = 0; v < jac.outerSize(); ++v) {
+        for(iterator_t jt(jac, v); jt; ++jt) {
+            // The rows of a column are sorted
+            if(jt.row() < first) continue;
+            if(jt.row() >= last) break;
+            for(iterator_t it(jac, v); it; ++it) {
+                cov(it.row(), jt.row()) += it.value() * jt.value();
+            }
+        }
+    }
+}
+
+} // namespace detail_
+
+/** @brief The covariance matrix of a set of Uncertain values
+ *
+ *  With J the Jacobian of the values with respect to the independent
+ *  variables and D the diagonal matrix of the standard deviations of those
+ *  variables, the covariance matrix is (J D) (J D)^T. The Jacobian is
+ *  gathered once as a sparse matrix, and each variable only contributes to
+ *  the pairs of values that both depend on it. The diagonal is the variance
+ *  of each value, i.e. its sd() squared.
+ *
+ *  When built with OpenMP, large covariance matrices are split into blocks
+ *  of columns, one per thread.
+ *
+ *  @code
+ *  Eigen::Matrix<sigma::UDouble, Eigen::Dynamic, 1> params = fit(...);
+ *  Eigen::MatrixXd cov = sigma::covariance_matrix(params);
+ *  @endcode
+ *
+ *  @tparam Derived The type of the matrix or vector
+ *  @param results The values. The elements of a matrix are taken in
+ *                 column-major order.
+ *
+ *  @return The symmetric covariance matrix, with one row and column per
+ *          element of @p results
+ *
+ *  @throw std::bad_alloc if there is insufficient memory for the result or
+ *         the intermediates. Strong throw guarantee.
+ */
+template<typename Derived>
+Eigen::Matrix<typename Derived::Scalar::value_t, Eigen::Dynamic,
+              Eigen::Dynamic>
+covariance_matrix(const Eigen::DenseBase<Derived>& results) {
+    using value_t    = typename Derived::Scalar::value_t;
+    using matrix_t   = Eigen::Matrix<value_t, Eigen::Dynamic, Eigen::Dynamic>;
+    using iterator_t = typename detail_::jacobian_t<value_t>::InnerIterator;
+
+    // Covariance matrices needing fewer multiply-adds than this are not worth
+    // threading
+    constexpr Eigen::Index parallel_threshold = 1 << 15;
+
+    SIGMA_TRACE("covariance_matrix", detail_::total_deps(results));
+
+    detail_::DependencyIndex<value_t> index;
+    index.add(results);
+    index.finalize();
+    auto jac = detail_::gather_jacobian(results, index);
+
+    Eigen::Index work = 0;
+    for(Eigen::Index v = 0; v < jac.outerSize(); ++v) {
+        const value_t sd = *index.variable(static_cast<std::size_t>(v));
+        for(iterator_t it(jac, v); it; ++it) it.valueRef() *= sd;
+        const Eigen::Index nnz = jac.col(v).nonZeros();
+        work += nnz * nnz;
+    }
+
+    const Eigen::Index n = results.size();
+    matrix_t cov         = matrix_t::Zero(n, n);
+    [[maybe_unused]] const bool parallel = work >= parallel_threshold;
+    SIGMA_OMP(parallel if(parallel))
+    {
+        auto [first, last] = detail_::thread_range(n);
+        detail_::covariance_columns(jac, first, last, cov);
+    }
+    return cov;
+}
+
+} // namespace sigma
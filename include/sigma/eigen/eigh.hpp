@@ -0,0 +1,145 @@
+#pragma once
+#include "sigma/detail_/jacobian.hpp"
+#include "sigma/detail_/setter.hpp"
+#include "sigma/trace.hpp"
+#include "sigma/uncertain.hpp"
+#include <Eigen/Dense>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/** @file eigh.hpp
+ *  @brief Eigendecomposition of symmetric matrices with Uncertain elements
+ */
+
+namespace sigma {
+
+/** @brief Eigenvalues and eigenvectors of a symmetric matrix
+ *
+ *  Solves the eigenproblem of the mean matrix with plain floating point
+ *  arithmetic and takes the derivatives from first-order perturbation
+ *  theory. With A = V diag(w) V^T, a perturbation dA gives
+ *
+ *  - dw_k = v_k^T dA v_k
+ *  - dv_k = sum over l != k of (v_l^T dA v_k) / (w_k - w_l) v_l
+ *
+ *  Running Eigen::SelfAdjointEigenSolver on Uncertain values instead merges
+ *  dependency maps at every step of its iterations. Like that solver, only
+ *  the lower triangle of @p a is read. The eigenvalues must be distinct for
+ *  the eigenvectors to be differentiable; otherwise their derivatives are
+ *  not finite.
+ *
+ *  Every result depends on every variable of the lower triangle of @p a.
+ *  Propagating a variable that appears in element (i, j) uses the product
+ *  V diag(V(i, :)) F, where F holds the inverse eigenvalue gaps, which is
+ *  computed once per row of @p a and kept, so the memory used grows with the
+ *  cube of the size of @p a.
+ *
+ *  @code
+ *  auto [values, vectors] = sigma::eigh(A);
+ *  @endcode
+ *
+ *  @tparam Derived The type of the matrix
+ *  @param a The symmetric matrix
+ *
+ *  @return The eigenvalues, in increasing order, and the normalized
+ *          eigenvectors, as the columns of a matrix in the same order
+ *
+ *  @throw std::invalid_argument if @p a is not square. Strong throw guarantee.
+ *  @throw std::runtime_error if the eigenvalues of the mean matrix do not
+ *         converge. Strong throw guarantee.
+ *  @throw std::bad_alloc if there is insufficient memory for the results or
+ *         the intermediates. Strong throw guarantee.
+ */
+template<typename Derived>
+std::pair<Eigen::Matrix<typename Derived::Scalar, Eigen::Dynamic, 1>,
+          Eigen::Matrix<typename Derived::Scalar, Eigen::Dynamic,
+                        Eigen::Dynamic>>
+eigh(const Eigen::MatrixBase<Derived>& a) {
+    using uncertain_t = typename Derived::Scalar;
+    using value_t     = typename uncertain_t::value_t;
+    using matrix_t    = Eigen::Matrix<value_t, Eigen::Dynamic, Eigen::Dynamic>;
+    using umatrix_t =
+      Eigen::Matrix<uncertain_t, Eigen::Dynamic, Eigen::Dynamic>;
+    using iterator_t = typename detail_::jacobian_t<value_t>::InnerIterator;
+    using setter_t   = detail_::Setter<uncertain_t>;
+
+    SIGMA_TRACE("eigh", detail_::total_deps(a));
+
+    if(a.rows() != a.cols()) {
+        throw std::invalid_argument("eigh: matrix is not square");
+    }
+    const Eigen::Index n = a.rows();
+
+    umatrix_t lower = a.template triangularView<Eigen::Lower>();
+    Eigen::SelfAdjointEigenSolver<matrix_t> solver(
+      detail_::mean_matrix(lower));
+    if(solver.info() != Eigen::Success) {
+        throw std::runtime_error("eigh: eigenvalues did not converge");
+    }
+    const auto& w = solver.eigenvalues();
+    const auto& v = solver.eigenvectors();
+
+    detail_::DependencyIndex<value_t> index;
+    index.add(lower);
+    index.finalize();
+    auto jac = detail_::gather_jacobian(lower, index);
+
+    umatrix_t values  = detail_::certain_matrix(w);
+    umatrix_t vectors = detail_::certain_matrix(v);
+
+    // Inverse eigenvalue gaps, F(l, k) = 1 / (w_k - w_l) for l != k
+    matrix_t f = matrix_t::Zero(n, n);
+    for(Eigen::Index k = 0; k < n; ++k) {
+        for(Eigen::Index l = 0; l < n; ++l) {
+            if(l != k) f(l, k) = 1 / (w(k) - w(l));
+        }
+    }
+
+    // h[i] = V diag(V(i, :)) F, computed when first needed
+    std::vector<matrix_t> h(static_cast<std::size_t>(n));
+    auto h_row = [&](Eigen::Index i) -> const matrix_t& {
+        auto& hi = h[static_cast<std::size_t>(i)];
+        if(hi.size() == 0) {
+            hi = (v.array().rowwise() * v.row(i).array()).matrix() * f;
+        }
+        return hi;
+    };
+
+    Eigen::Matrix<value_t, Eigen::Dynamic, 1> dw(n);
+    matrix_t dv(n, n);
+    for(Eigen::Index c = 0; c < jac.outerSize(); ++c) {
+        dw.setZero();
+        dv.setZero();
+        for(iterator_t it(jac, c); it; ++it) {
+            const Eigen::Index i = it.row() % n;
+            const Eigen::Index j = it.row() / n;
+            const value_t x      = it.value();
+            if(i == j) {
+                dw += x * v.row(i).cwiseAbs2().transpose();
+                dv += x * h_row(i) * v.row(i).asDiagonal();
+            } else {
+                dw += 2 * x * v.row(i).cwiseProduct(v.row(j)).transpose();
+                dv += x * h_row(i) * v.row(j).asDiagonal();
+                dv += x * h_row(j) * v.row(i).asDiagonal();
+            }
+        }
+
+        const auto& dep = index.variable(static_cast<std::size_t>(c));
+        for(Eigen::Index k = 0; k < n; ++k) {
+            setter_t(values(k, 0)).add_dependency(dep, dw(k));
+        }
+        for(Eigen::Index k = 0; k < n; ++k) {
+            for(Eigen::Index p = 0; p < n; ++p) {
+                setter_t(vectors(p, k)).add_dependency(dep, dv(p, k));
+            }
+        }
+    }
+
+    detail_::update_sds(values);
+    detail_::update_sds(vectors);
+    return {std::move(values), std::move(vectors)};
+}
+
+} // namespace sigma
@@ -0,0 +1,199 @@
+#pragma once
+#include "sigma/detail_/jacobian.hpp"
+#include "sigma/detail_/setter.hpp"
+#include "sigma/trace.hpp"
+#include "sigma/uncertain.hpp"
+#include <Eigen/Dense>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+/** @file inverse.hpp
+ *  @brief Determinants and inverses of matrices with Uncertain elements
+ */
+
+namespace sigma {
+namespace detail_ {
+
+/** @brief A scalar function of a matrix from its value and gradient
+ *
+ *  @tparam Derived The type of the matrix
+ *  @tparam T The value type of the variables
+ *  @param a The matrix
+ *  @param value The value of the function at the mean of @p a
+ *  @param gradient The derivative of the function with respect to each
+ *                  element of @p a
+ *
+ *  @return The function value, depending on every variable of @p a
+ *
+ *  @throw std::bad_alloc if there is insufficient memory for the result or
+ *         the intermediates. Strong throw guarantee.
+ */
+template<typename Derived, typename T>
+Uncertain<T> matrix_scalar_function(
+  const Eigen::MatrixBase<Derived>& a, T value,
+  const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& gradient) {
+    using vector_t = Eigen::Matrix<T, Eigen::Dynamic, 1>;
+
+    DependencyIndex<T> index;
+    index.add(a);
+    index.finalize();
+    auto jac = gather_jacobian(a, index);
+
+    // Chain rule for every variable at once: J^T vec(gradient)
+    Eigen::Map<const vector_t> g(gradient.data(), gradient.size());
+    vector_t derivs = jac.transpose() * g;
+
+    Uncertain<T> c(value);
+    Setter<Uncertain<T>> setter(c);
+    for(std::size_t v = 0; v < index.size(); ++v) {
+        setter.add_dependency(index.variable(v),
+                              derivs(static_cast<Eigen::Index>(v)));
+    }
+    setter.update_sd();
+    return c;
+}
+
+/** @brief The LU factorization of the mean of a square matrix
+ *
+ *  @tparam Derived The type of the matrix
+ *  @param a The matrix
+ *  @param caller The name of the calling function, for the error message
+ *
+ *  @return The factorization, with partial pivoting
+ *
+ *  @throw std::invalid_argument if @p a is not square. Strong throw
+ *         guarantee.
+ *  @throw std::bad_alloc if there is insufficient memory for the
+ *         factorization. Strong throw guarantee.
+ */
+template<typename Derived>
+auto mean_lu(const Eigen::MatrixBase<Derived>& a, const char* caller) {
+    if(a.rows() != a.cols()) {
+        throw std::invalid_argument(std::string(caller) +
+                                    ": matrix is not square");
+    }
+    return mean_matrix(a.derived()).partialPivLu();
+}
+
+} // namespace detail_
+
+/** @brief Determinant of a matrix with Uncertain elements
+ *
+ *  Computes the determinant of the mean matrix from its LU factorization and
+ *  propagates the uncertainty with d det(A) = det(A) tr(A^-1 dA), instead of
+ *  carrying the uncertainty through every pivot as Eigen's determinant does
+ *  for Uncertain values.
+ *
+ *  @tparam Derived The type of the matrix
+ *  @param a The square matrix. The derivatives are only finite if its mean
+ *           is invertible.
+ *
+ *  @return The determinant of @p a
+ *
+ *  @throw std::invalid_argument if @p a is not square. Strong throw guarantee.
+ *  @throw std::bad_alloc if there is insufficient memory for the result or
+ *         the intermediates. Strong throw guarantee.
+ */
+template<typename Derived>
+typename Derived::Scalar det(const Eigen::MatrixBase<Derived>& a) {
+    using value_t  = typename Derived::Scalar::value_t;
+    using matrix_t = Eigen::Matrix<value_t, Eigen::Dynamic, Eigen::Dynamic>;
+
+    SIGMA_TRACE("det", detail_::total_deps(a));
+
+    auto lu       = detail_::mean_lu(a, "det");
+    value_t value = lu.determinant();
+    // d det / dA_ij = det (A^-1)_ji
+    matrix_t grad = value * lu.inverse().transpose();
+    return detail_::matrix_scalar_function(a, value, grad);
+}
+
+/** @brief Logarithm of the absolute value of a determinant
+ *
+ *  Computed from the LU factorization of the mean matrix as the sum of the
+ *  logarithms of the pivots, so that it neither overflows nor underflows for
+ *  large matrices. The uncertainty is propagated with
+ *  d log|det(A)| = tr(A^-1 dA). For the positive definite matrices of
+ *  Gaussian likelihoods this is the log-determinant itself.
+ *
+ *  @tparam Derived The type of the matrix
+ *  @param a The square matrix, whose mean must be invertible
+ *
+ *  @return The logarithm of the absolute value of the determinant of @p a
+ *
+ *  @throw std::invalid_argument if @p a is not square. Strong throw guarantee.
+ *  @throw std::bad_alloc if there is insufficient memory for the result or
+ *         the intermediates. Strong throw guarantee.
+ */
+template<typename Derived>
+typename Derived::Scalar logdet(const Eigen::MatrixBase<Derived>& a) {
+    using value_t  = typename Derived::Scalar::value_t;
+    using matrix_t = Eigen::Matrix<value_t, Eigen::Dynamic, Eigen::Dynamic>;
+
+    SIGMA_TRACE("logdet", detail_::total_deps(a));
+
+    auto lu       = detail_::mean_lu(a, "logdet");
+    value_t value = lu.matrixLU().diagonal().array().abs().log().sum();
+    matrix_t grad = lu.inverse().transpose();
+    return detail_::matrix_scalar_function(a, value, grad);
+}
+
+/** @brief Inverse of a matrix with Uncertain elements
+ *
+ *  Inverts the mean matrix and propagates the uncertainty with
+ *  dA^-1 = -A^-1 dA A^-1. A variable in element (i, j) of @p a thus
+ *  contributes the outer product of column i and row j of the inverse. Every
+ *  element of the result depends on every variable of @p a.
+ *
+ *  @tparam Derived The type of the matrix
+ *  @param a The square matrix, whose mean must be invertible
+ *
+ *  @return The inverse of @p a
+ *
+ *  @throw std::invalid_argument if @p a is not square. Strong throw guarantee.
+ *  @throw std::bad_alloc if there is insufficient memory for the result or
+ *         the intermediates. Strong throw guarantee.
+ */
+template<typename Derived>
+Eigen::Matrix<typename Derived::Scalar, Eigen::Dynamic, Eigen::Dynamic>
+inverse(const Eigen::MatrixBase<Derived>& a) {
+    using uncertain_t = typename Derived::Scalar;
+    using value_t     = typename uncertain_t::value_t;
+    using matrix_t    = Eigen::Matrix<value_t, Eigen::Dynamic, Eigen::Dynamic>;
+    using iterator_t  = typename detail_::jacobian_t<value_t>::InnerIterator;
+    using setter_t    = detail_::Setter<uncertain_t>;
+
+    SIGMA_TRACE("inverse", detail_::total_deps(a));
+
+    auto lu              = detail_::mean_lu(a, "inverse");
+    matrix_t x0          = lu.inverse();
+    const Eigen::Index n = x0.rows();
+
+    detail_::DependencyIndex<value_t> index;
+    index.add(a);
+    index.finalize();
+    auto jac = detail_::gather_jacobian(a, index);
+
+    auto x = detail_::certain_matrix(x0);
+    matrix_t dx(n, n);
+    for(Eigen::Index c = 0; c < jac.outerSize(); ++c) {
+        dx.setZero();
+        for(iterator_t it(jac, c); it; ++it) {
+            const Eigen::Index i = it.row() % n;
+            const Eigen::Index j = it.row() / n;
+            dx.noalias() -= it.value() * x0.col(i) * x0.row(j);
+        }
+        const auto& dep = index.variable(static_cast<std::size_t>(c));
+        for(Eigen::Index q = 0; q < n; ++q) {
+            for(Eigen::Index p = 0; p < n; ++p) {
+                setter_t(x(p, q)).add_dependency(dep, dx(p, q));
+            }
+        }
+    }
+
+    detail_::update_sds(x);
+    return x;
+}
+
+} // namespace sigma
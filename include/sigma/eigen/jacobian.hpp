@@ -0,0 +1,244 @@
+#pragma once
+#include "sigma/detail_/jacobian.hpp"
+#include "sigma/detail_/parallel.hpp"
+#include "sigma/trace.hpp"
+#include "sigma/uncertain.hpp"
+#include <Eigen/Dense>
+#include <Eigen/SparseCore>
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/** @file jacobian.hpp
+ *  @brief Export of the derivatives of Uncertain values
+ */
+
+namespace sigma {
+
+/** @brief The Jacobian of a set of Uncertain values
+ *
+ *  Row i of the matrix holds the derivatives of the i-th value with respect
+ *  to the independent variables, and column c belongs to the variable
+ *  `variables[c]`, whose standard deviation is `*variables[c]`. The matrix is
+ *  stored in compressed row (CSR) form, so `matrix.outerIndexPtr()`,
+ *  `matrix.innerIndexPtr()` and `matrix.valuePtr()` are the raw CSR arrays,
+ *  with the column indices of each row in increasing order.
+ *
+ *  @tparam T The value type of the variables
+ */
+template<typename T>
+struct Jacobian {
+    /// A pointer to an independent variable
+    using dep_sd_ptr = typename Uncertain<T>::dep_sd_ptr;
+
+    /// The type of the matrix
+    using matrix_t = Eigen::SparseMatrix<T, Eigen::RowMajor>;
+
+    /// The derivatives, with one row per value and one column per variable
+    matrix_t matrix;
+
+    /// The independent variable of each column
+    std::vector<dep_sd_ptr> variables;
+};
+
+namespace detail_ {
+
+/** @brief Assemble the Jacobian of a set of values in CSR form
+ *
+ *  The row pointers are found serially, after which the rows are filled
+ *  independently. When built with OpenMP, large Jacobians are filled by
+ *  blocks of rows, one per thread.
+ *
+ *  @tparam Derived The type of the matrix or vector of values
+ *  @tparam T The value type of the variables
+ *  @param results The values, taken in column-major order
+ *  @param index A finalized index containing the dependencies of @p results
+ *  @param columns The column of each variable of @p index in the result
+ *  @param n_cols The number of columns of the result
+ *
+ *  @return The Jacobian, with one row per element of @p results
+ *
+ *  @throw std::bad_alloc if there is insufficient memory for the result or
+ *         the intermediates. Strong throw guarantee.
+ */
+template<typename Derived, typename T>
+Eigen::SparseMatrix<T, Eigen::RowMajor> csr_jacobian(
+  const Eigen::DenseBase<Derived>& results, const DependencyIndex<T>& index,
+  const std::vector<Eigen::Index>& columns, Eigen::Index n_cols) {
+    using matrix_t  = Eigen::SparseMatrix<T, Eigen::RowMajor>;
+    using storage_t = typename matrix_t::StorageIndex;
+    using entry_t   = std::pair<storage_t, T>;
+
+    // Jacobians with fewer entries than this are not worth threading
+    constexpr Eigen::Index parallel_threshold = 1 << 15;
+
+    const Eigen::Index rows = results.rows();
+    const Eigen::Index n    = results.size();
+    auto element = [&results, rows](Eigen::Index r) -> decltype(auto) {
+        return results.derived()(r % rows, r / rows);
+    };
+
+    matrix_t jac(n, n_cols);
+    storage_t* outer = jac.outerIndexPtr();
+    for(Eigen::Index r = 0; r < n; ++r) {
+        const auto n_deps = static_cast<storage_t>(element(r).deps().size());
+        outer[r + 1]      = outer[r] + n_deps;
+    }
+    jac.resizeNonZeros(outer[n]);
+    storage_t* inner = jac.innerIndexPtr();
+    T* values        = jac.valuePtr();
+
+    [[maybe_unused]] const bool parallel = outer[n] >= parallel_threshold;
+    std::exception_ptr error;
+    SIGMA_OMP(parallel if(parallel))
+    {
+        auto [first, last] = thread_range(n);
+        try {
+            // The dependencies are in key order, so each row is sorted here
+            std::vector<entry_t> row;
+            for(Eigen::Index r = first; r < last; ++r) {
+                row.clear();
+                for(const auto& [dep, deriv] : element(r).deps()) {
+                    auto c = columns[index.column(dep)];
+                    row.emplace_back(static_cast<storage_t>(c), deriv);
+                }
+                std::sort(row.begin(), row.end());
+                storage_t k = outer[r];
+                for(const auto& [c, deriv] : row) {
+                    inner[k]  = c;
+                    values[k] = deriv;
+                    ++k;
+                }
+            }
+        } catch(...) {
+            SIGMA_OMP(critical)
+            error = std::current_exception();
+        }
+    }
+    if(error) std::rethrow_exception(error);
+    return jac;
+}
+
+} // namespace detail_
+
+/** @brief The Jacobian of a set of Uncertain values
+ *
+ *  Gathers the derivatives of every value with respect to the independent
+ *  variables it depends on. The columns are numbered in the order in which
+ *  the variables are first encountered, going through @p results in order.
+ *  The variables of a single value are encountered in the order of their
+ *  dependency map, which depends on where they are stored in memory. Use the
+ *  overload taking the inputs when the columns must be the same from run to
+ *  run.
+ *
+ *  @tparam Derived The type of the matrix or vector
+ *  @param results The values. The elements of a matrix are taken in
+ *                 column-major order.
+ *
+ *  @return The Jacobian, with one row per element of @p results and one
+ *          column per variable they depend on
+ *
+ *  @throw std::bad_alloc if there is insufficient memory for the result or
+ *         the intermediates. Strong throw guarantee.
+ */
+template<typename Derived>
+Jacobian<typename Derived::Scalar::value_t> jacobian(
+  const Eigen::DenseBase<Derived>& results) {
+    using value_t = typename Derived::Scalar::value_t;
+
+    SIGMA_TRACE("jacobian", detail_::total_deps(results));
+
+    detail_::DependencyIndex<value_t> index;
+    index.add(results);
+    index.finalize();
+
+    Jacobian<value_t> jac;
+    std::vector<Eigen::Index> columns(index.size(), -1);
+    jac.variables.reserve(index.size());
+    for(Eigen::Index j = 0; j < results.cols(); ++j) {
+        for(Eigen::Index i = 0; i < results.rows(); ++i) {
+            for(const auto& [dep, deriv] : results.derived()(i, j).deps()) {
+                auto& c = columns[index.column(dep)];
+                if(c >= 0) continue;
+                c = static_cast<Eigen::Index>(jac.variables.size());
+                jac.variables.push_back(dep);
+            }
+        }
+    }
+
+    const auto n_cols = static_cast<Eigen::Index>(jac.variables.size());
+    jac.matrix = detail_::csr_jacobian(results, index, columns, n_cols);
+    return jac;
+}
+
+/** @brief The Jacobian of a set of Uncertain values with respect to inputs
+ *
+ *  Column c holds the derivatives with respect to the c-th input, so the
+ *  columns follow the order of @p inputs, e.g. the parameters of a model,
+ *  and do not depend on where the variables are stored in memory.
+ *
+ *  @tparam Derived The type of the matrix or vector of values
+ *  @tparam InputType The type of the matrix or vector of inputs
+ *  @param results The values. The elements of a matrix are taken in
+ *                 column-major order.
+ *  @param inputs The independent variables, each of which must depend on
+ *                exactly one variable, with a derivative of 1. Taken in
+ *                column-major order.
+ *
+ *  @return The Jacobian, with one row per element of @p results and one
+ *          column per element of @p inputs
+ *
+ *  @throw std::invalid_argument if an input is not an independent variable,
+ *         if two inputs are the same variable, or if @p results depend on a
+ *         variable that is not an input. Strong throw guarantee.
+ *  @throw std::bad_alloc if there is insufficient memory for the result or
+ *         the intermediates. Strong throw guarantee.
+ */
+template<typename Derived, typename InputType>
+Jacobian<typename Derived::Scalar::value_t> jacobian(
+  const Eigen::DenseBase<Derived>& results,
+  const Eigen::DenseBase<InputType>& inputs) {
+    using value_t = typename Derived::Scalar::value_t;
+
+    SIGMA_TRACE("jacobian",
+                detail_::total_deps(results) + detail_::total_deps(inputs));
+
+    detail_::DependencyIndex<value_t> index;
+    index.add(results);
+    index.add(inputs);
+    index.finalize();
+
+    Jacobian<value_t> jac;
+    std::vector<Eigen::Index> columns(index.size(), -1);
+    jac.variables.reserve(static_cast<std::size_t>(inputs.size()));
+    for(Eigen::Index j = 0; j < inputs.cols(); ++j) {
+        for(Eigen::Index i = 0; i < inputs.rows(); ++i) {
+            const auto& deps = inputs.derived()(i, j).deps();
+            // A scaled variable, e.g. 2 * x, also has a single dependency
+            if(deps.size() != 1 || deps.begin()->second != value_t{1}) {
+                throw std::invalid_argument(
+                  "jacobian: input is not an independent variable");
+            }
+            const auto& dep = deps.begin()->first;
+            auto& c         = columns[index.column(dep)];
+            if(c >= 0) {
+                throw std::invalid_argument("jacobian: repeated input");
+            }
+            c = static_cast<Eigen::Index>(jac.variables.size());
+            jac.variables.push_back(dep);
+        }
+    }
+    if(std::find(columns.begin(), columns.end(), -1) != columns.end()) {
+        throw std::invalid_argument(
+          "jacobian: results depend on a variable that is not an input");
+    }
+
+    const auto n_cols = static_cast<Eigen::Index>(jac.variables.size());
+    jac.matrix = detail_::csr_jacobian(results, index, columns, n_cols);
+    return jac;
+}
+
+} // namespace sigma
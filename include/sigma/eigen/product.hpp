@@ -0,0 +1,431 @@
+#pragma once
+#include "sigma/detail_/jacobian.hpp"
+#include "sigma/detail_/parallel.hpp"
+#include "sigma/detail_/setter.hpp"
+#include "sigma/operations/arithmetic.hpp"
+#include "sigma/policies.hpp"
+#include "sigma/trace.hpp"
+#include "sigma/uncertain.hpp"
+#include <Eigen/Dense>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/** @file product.hpp
+ *  @brief Matrix products of Uncertain values
+ *
+ *  Eigen's generic product kernels construct an Uncertain value, and merge
+ *  two dependency maps, for every multiply-add. For matrices of Uncertain
+ *  values the product is instead split into a product of the mean values,
+ *  done with Eigen's optimized floating point kernels, and sparse-dense
+ *  products for the derivatives with respect to each independent variable.
+ *  The results are assembled once at the end.
+ *
+ *  Products of a plain floating point matrix and a matrix of Uncertain values
+ *  take the same route, with the certain matrix used directly as its means.
+ */
+
+namespace sigma::detail_ {
+
+/** @brief The operands of a split product, in the form used by the kernel
+ *
+ *  @tparam T The value type of the variables
+ */
+template<typename T>
+struct SplitOperands {
+    /// The type of the mean matrices
+    using matrix_t = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>;
+
+    /// The means of the left matrix
+    matrix_t a0;
+
+    /// The transposed means of the right matrix, so its rows are contiguous
+    matrix_t b0t;
+
+    /// The variables of both matrices
+    DependencyIndex<T> index;
+
+    /// The Jacobian of the left matrix
+    jacobian_t<T> ja;
+
+    /// The Jacobian of the right matrix
+    jacobian_t<T> jb;
+};
+
+/** @brief The derivatives of a block of columns of a split product
+ *
+ *  Entry k adds variable `variables[k]` of the index, with derivative
+ *  `derivs[k]`, to element `elements[k]` of the product, a column-major
+ *  linear index. The entries of each element are in key order.
+ *
+ *  @tparam T The value type of the variables
+ */
+template<typename T>
+struct SplitBlock {
+    /// The element of the product each entry is added to
+    std::vector<Eigen::Index> elements;
+
+    /// The variable of each entry
+    std::vector<std::size_t> variables;
+
+    /// The derivative of each entry
+    std::vector<T> derivs;
+};
+
+/** @brief Compute the derivatives of a block of columns of a split product
+ *
+ *  Only reads the operands, and touches none of the keys, so blocks can be
+ *  computed concurrently.
+ *
+ *  @tparam T The value type of the variables
+ *  @param ops The operands
+ *  @param first The first column of the block
+ *  @param last One past the last column of the block
+ *  @param block Receives the derivatives of the elements in the block
+ *
+ *  @throw std::bad_alloc if there is insufficient memory for the
+ *         derivatives. Weak throw guarantee.
+ */
+template<typename T>
+void split_product_derivatives(const SplitOperands<T>& ops, Eigen::Index first,
+                               Eigen::Index last, SplitBlock<T>& block) {
+    using matrix_t   = typename SplitOperands<T>::matrix_t;
+    using iterator_t = typename jacobian_t<T>::InnerIterator;
+
+    const Eigen::Index m     = ops.a0.rows();
+    const Eigen::Index depth = ops.a0.cols();
+    const Eigen::Index width = last - first;
+
+    // The rows and columns of the block touched by the current variable, and
+    // the position of each in the buffers below (-1 if untouched)
+    std::vector<Eigen::Index> rows, cols;
+    std::vector<Eigen::Index> row_slot(m, -1), col_slot(width, -1);
+    // (dA/dv) B, one column per touched row, and A (dB/dv), one column per
+    // touched column
+    matrix_t row_part, col_part;
+
+    auto add = [&block, m, first](Eigen::Index i, Eigen::Index j,
+                                  std::size_t v, T deriv) {
+        block.elements.push_back((first + j) * m + i);
+        block.variables.push_back(v);
+        block.derivs.push_back(deriv);
+    };
+
+    for(Eigen::Index v = 0; v < ops.ja.outerSize(); ++v) {
+        rows.clear();
+        cols.clear();
+        for(iterator_t it(ops.ja, v); it; ++it) {
+            Eigen::Index i = it.row() % m;
+            if(row_slot[i] >= 0) continue;
+            row_slot[i] = static_cast<Eigen::Index>(rows.size());
+            rows.push_back(i);
+        }
+        for(iterator_t it(ops.jb, v); it; ++it) {
+            Eigen::Index j = it.row() / depth - first;
+            if(j < 0 || j >= width || col_slot[j] >= 0) continue;
+            col_slot[j] = static_cast<Eigen::Index>(cols.size());
+            cols.push_back(j);
+        }
+        if(rows.empty() && cols.empty()) continue;
+
+        row_part.setZero(width, static_cast<Eigen::Index>(rows.size()));
+        col_part.setZero(m, static_cast<Eigen::Index>(cols.size()));
+        for(iterator_t it(ops.ja, v); it; ++it) {
+            Eigen::Index i = it.row() % m;
+            Eigen::Index k = it.row() / m;
+            row_part.col(row_slot[i]) +=
+              it.value() * ops.b0t.col(k).segment(first, width);
+        }
+        for(iterator_t it(ops.jb, v); it; ++it) {
+            Eigen::Index j = it.row() / depth - first;
+            if(j < 0 || j >= width) continue;
+            Eigen::Index k = it.row() % depth;
+            col_part.col(col_slot[j]) += it.value() * ops.a0.col(k);
+        }
+
+        const auto var = static_cast<std::size_t>(v);
+        for(Eigen::Index j = 0; j < width; ++j) {
+            if(col_slot[j] >= 0) {
+                for(Eigen::Index i = 0; i < m; ++i) {
+                    T dcdv = col_part(i, col_slot[j]);
+                    if(row_slot[i] >= 0) dcdv += row_part(j, row_slot[i]);
+                    add(i, j, var, dcdv);
+                }
+            } else {
+                for(auto i : rows) add(i, j, var, row_part(j, row_slot[i]));
+            }
+        }
+
+        for(auto i : rows) row_slot[i] = -1;
+        for(auto j : cols) col_slot[j] = -1;
+    }
+}
+
+/** @brief Copy the keys of the variables of a split product for one thread
+ *
+ *  The variables made together by make_independent share one control block,
+ *  so copying their keys on several threads at once contends on its use
+ *  count. Each thread instead copies the keys once, into a vector it owns,
+ *  and gives the entries of its block keys that alias these copies. An
+ *  aliasing key points to the same cell, so it compares equal to the
+ *  original, but its copies only count uses of the thread's vector. The
+ *  vector keeps every variable of the product alive while any element of
+ *  the product refers to it.
+ *
+ *  @tparam T The value type of the variables
+ *  @param index The variables of the product
+ *
+ *  @return The copies of the keys of @p index, in the order of the index
+ *
+ *  @throw std::bad_alloc if there is insufficient memory for the keys.
+ *         Strong throw guarantee.
+ */
+template<typename T>
+auto split_product_keys(const DependencyIndex<T>& index) {
+    using dep_sd_ptr = typename DependencyIndex<T>::dep_sd_ptr;
+    auto keys        = std::make_shared<std::vector<dep_sd_ptr>>();
+    keys->reserve(index.size());
+    for(std::size_t v = 0; v < index.size(); ++v) {
+        keys->push_back(index.variable(v));
+    }
+    return std::shared_ptr<const std::vector<dep_sd_ptr>>(std::move(keys));
+}
+
+/** @brief Add the entries of a block of columns to a split product
+ *
+ *  Each entry gets a key that aliases its copy in @p keys, so only the use
+ *  count of @p keys changes. Only the elements of columns [@p first,
+ *  @p last) of @p c are written, so blocks that do not overlap can be
+ *  assembled concurrently, each with its own @p keys.
+ *
+ *  @tparam T The value type of the variables
+ *  @param block The entries of the block
+ *  @param keys The keys of the variables, from split_product_keys
+ *  @param first The first column of the block
+ *  @param last One past the last column of the block
+ *  @param c The product, whose elements in the block hold the mean values
+ *
+ *  @throw std::bad_alloc if there is insufficient memory for the
+ *         dependencies. Weak throw guarantee.
+ */
+template<typename T>
+void split_product_assemble(
+  const SplitBlock<T>& block,
+  const std::shared_ptr<
+    const std::vector<typename DependencyIndex<T>::dep_sd_ptr>>& keys,
+  Eigen::Index first, Eigen::Index last,
+  Eigen::Matrix<Uncertain<T>, Eigen::Dynamic, Eigen::Dynamic>& c) {
+    using dep_sd_ptr = typename DependencyIndex<T>::dep_sd_ptr;
+    using setter_t   = Setter<Uncertain<T>>;
+
+    for(std::size_t k = 0; k < block.variables.size(); ++k) {
+        const auto& key = (*keys)[block.variables[k]];
+        setter_t(c(block.elements[k]))
+          .add_dependency(dep_sd_ptr(keys, key.get()), block.derivs[k]);
+    }
+    for(Eigen::Index j = first; j < last; ++j) {
+        for(Eigen::Index i = 0; i < c.rows(); ++i) {
+            setter_t(c(i, j)).update_sd();
+        }
+    }
+}
+
+/** @brief Multiply two matrices of Uncertain values
+ *
+ *  With C = A B, the derivative with respect to a variable v is
+ *  dC/dv = (dA/dv) B + A (dB/dv). The first term only touches the rows of C
+ *  whose row of A depends on v, the second only the columns of C whose column
+ *  of B does, so each variable costs time proportional to the number of
+ *  elements it affects. The variables are processed in key order, so that
+ *  every dependency is appended to the end of its dependency map.
+ *
+ *  An element of the result depends on exactly the variables of its row of
+ *  @p lhs and its column of @p rhs, as it does with the element-wise
+ *  product.
+ *
+ *  Either operand may instead be a matrix of floating point values, which is
+ *  used as is and contributes no derivatives.
+ *
+ *  When built with OpenMP, large products are split into blocks of columns
+ *  of the result, one per thread. Each thread computes the derivatives of
+ *  its own block, copies the keys once (see split_product_keys) and adds the
+ *  entries to the elements of its block. The operands are only read and the
+ *  elements only written by one thread, so no locking is needed. What
+ *  remains serial is gathering the Jacobians and the product of the means:
+ *  for a 100 x 100 product of independent variables on one thread, about 1%
+ *  of the time, against 9% for the derivatives and 90% for the assembly.
+ *
+ *  @tparam T The value type of the variables
+ *  @tparam LhsType The type of the left matrix, of Uncertain<T> or T values
+ *  @tparam RhsType The type of the right matrix, of Uncertain<T> or T values
+ *  @param lhs The left matrix
+ *  @param rhs The right matrix
+ *
+ *  @return The product @p lhs times @p rhs
+ *
+ *  @throw std::bad_alloc if there is insufficient memory for the result or
+ *         the intermediates. Strong throw guarantee.
+ */
+template<typename T, typename LhsType, typename RhsType>
+Eigen::Matrix<Uncertain<T>, Eigen::Dynamic, Eigen::Dynamic> split_product(
+  const LhsType& lhs, const RhsType& rhs) {
+    // Products with fewer multiply-adds than this are not worth threading
+    constexpr Eigen::Index parallel_threshold = 1 << 15;
+    constexpr bool uncertain_lhs = is_uncertain_v<typename LhsType::Scalar>;
+    constexpr bool uncertain_rhs = is_uncertain_v<typename RhsType::Scalar>;
+
+    SIGMA_TRACE("product",
+                detail_::total_deps(lhs) + detail_::total_deps(rhs));
+
+    SplitOperands<T> ops;
+    if constexpr(uncertain_lhs) {
+        ops.a0 = mean_matrix(lhs);
+        ops.index.add(lhs);
+    } else {
+        ops.a0 = lhs;
+    }
+    if constexpr(uncertain_rhs) {
+        ops.b0t = mean_matrix(rhs).transpose();
+        ops.index.add(rhs);
+    } else {
+        ops.b0t = rhs.transpose();
+    }
+    ops.index.finalize();
+
+    // A certain operand has no derivatives, so its Jacobian stays empty
+    const auto n_vars = static_cast<Eigen::Index>(ops.index.size());
+    if constexpr(uncertain_lhs) {
+        ops.ja = gather_jacobian(lhs, ops.index);
+    } else {
+        ops.ja.resize(lhs.size(), n_vars);
+    }
+    if constexpr(uncertain_rhs) {
+        ops.jb = gather_jacobian(rhs, ops.index);
+    } else {
+        ops.jb.resize(rhs.size(), n_vars);
+    }
+
+    auto c = certain_matrix(ops.a0 * ops.b0t.transpose());
+
+    const Eigen::Index n = c.cols();
+    [[maybe_unused]] const bool parallel =
+      c.size() * lhs.cols() >= parallel_threshold;
+    std::exception_ptr error;
+    SIGMA_OMP(parallel if(parallel))
+    {
+        auto [first, last] = thread_range(n);
+        try {
+            SplitBlock<T> block;
+            split_product_derivatives(ops, first, last, block);
+            const auto keys = split_product_keys(ops.index);
+            split_product_assemble(block, keys, first, last, c);
+        } catch(...) {
+            SIGMA_OMP(critical)
+            error = std::current_exception();
+        }
+    }
+    if(error) std::rethrow_exception(error);
+    return c;
+}
+
+/** @brief Eigen product implementation for matrices of Uncertain values
+ *
+ *  Provides the interface Eigen expects of a product implementation, with
+ *  every variant forwarding to split_product.
+ *
+ *  @tparam T The value type of the variables
+ *  @tparam LhsType The type of the left matrix
+ *  @tparam RhsType The type of the right matrix
+ */
+template<typename T, typename LhsType, typename RhsType>
+struct SplitProduct {
+    /// The type of the elements of the product
+    using Scalar = Uncertain<T>;
+
+    /// Assign the product to @p dst
+    template<typename DstType>
+    static void evalTo(DstType& dst, const LhsType& lhs, const RhsType& rhs) {
+        auto c = split_product<T>(lhs, rhs);
+        for(Eigen::Index j = 0; j < c.cols(); ++j) {
+            for(Eigen::Index i = 0; i < c.rows(); ++i) {
+                dst.coeffRef(i, j) = std::move(c(i, j));
+            }
+        }
+    }
+
+    /// Add the product to @p dst
+    template<typename DstType>
+    static void addTo(DstType& dst, const LhsType& lhs, const RhsType& rhs) {
+        auto c = split_product<T>(lhs, rhs);
+        for(Eigen::Index j = 0; j < c.cols(); ++j) {
+            for(Eigen::Index i = 0; i < c.rows(); ++i) {
+                dst.coeffRef(i, j) += c(i, j);
+            }
+        }
+    }
+
+    /// Subtract the product from @p dst
+    template<typename DstType>
+    static void subTo(DstType& dst, const LhsType& lhs, const RhsType& rhs) {
+        auto c = split_product<T>(lhs, rhs);
+        for(Eigen::Index j = 0; j < c.cols(); ++j) {
+            for(Eigen::Index i = 0; i < c.rows(); ++i) {
+                dst.coeffRef(i, j) -= c(i, j);
+            }
+        }
+    }
+
+    /// Add the product, scaled by @p alpha, to @p dst
+    template<typename DstType>
+    static void scaleAndAddTo(DstType& dst, const LhsType& lhs,
+                              const RhsType& rhs, const Scalar& alpha) {
+        auto c = split_product<T>(lhs, rhs);
+        for(Eigen::Index j = 0; j < c.cols(); ++j) {
+            for(Eigen::Index i = 0; i < c.rows(); ++i) {
+                dst.coeffRef(i, j) += alpha * c(i, j);
+            }
+        }
+    }
+};
+
+} // namespace sigma::detail_
+
+/** @def SIGMA_SPLIT_PRODUCT(lhs_scalar, rhs_scalar, product_tag)
+ *  @brief Routes a kind of product involving Uncertain matrices to SplitProduct
+ *
+ *  Only plain matrices are matched. Products involving other expressions
+ *  (blocks, transposes, scaled matrices, ...) keep using Eigen's generic
+ *  kernels, and can be routed here by evaluating the operands first.
+ */
+#define SIGMA_SPLIT_PRODUCT(lhs_scalar, rhs_scalar, product_tag)              \
+    /** @brief Split product implementation for Uncertain matrices */         \
+    template<typename T, int LhsRows, int LhsCols, int LhsOptions,            \
+             int LhsMaxRows, int LhsMaxCols, int RhsRows, int RhsCols,        \
+             int RhsOptions, int RhsMaxRows, int RhsMaxCols>                  \
+    struct generic_product_impl<                                              \
+      Matrix<lhs_scalar, LhsRows, LhsCols, LhsOptions, LhsMaxRows,            \
+             LhsMaxCols>,                                                     \
+      Matrix<rhs_scalar, RhsRows, RhsCols, RhsOptions, RhsMaxRows,            \
+             RhsMaxCols>,                                                     \
+      DenseShape, DenseShape, product_tag>                                    \
+      : sigma::detail_::SplitProduct<                                         \
+          T,                                                                  \
+          Matrix<lhs_scalar, LhsRows, LhsCols, LhsOptions, LhsMaxRows,        \
+                 LhsMaxCols>,                                                 \
+          Matrix<rhs_scalar, RhsRows, RhsCols, RhsOptions, RhsMaxRows,        \
+                 RhsMaxCols>> {}
+
+namespace Eigen::internal {
+
+SIGMA_SPLIT_PRODUCT(sigma::Uncertain<T>, sigma::Uncertain<T>, GemmProduct);
+SIGMA_SPLIT_PRODUCT(sigma::Uncertain<T>, sigma::Uncertain<T>, GemvProduct);
+SIGMA_SPLIT_PRODUCT(T, sigma::Uncertain<T>, GemmProduct);
+SIGMA_SPLIT_PRODUCT(T, sigma::Uncertain<T>, GemvProduct);
+SIGMA_SPLIT_PRODUCT(sigma::Uncertain<T>, T, GemmProduct);
+SIGMA_SPLIT_PRODUCT(sigma::Uncertain<T>, T, GemvProduct);
+
+} // namespace Eigen::internal
+
+#undef SIGMA_SPLIT_PRODUCT
@@ -0,0 +1,195 @@
+#pragma once
+#include "sigma/detail_/jacobian.hpp"
+#include "sigma/detail_/setter.hpp"
+#include "sigma/trace.hpp"
+#include "sigma/uncertain.hpp"
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/** @file solve.hpp
+ *  @brief Linear systems with Uncertain coefficients
+ */
+
+namespace sigma {
+namespace detail_ {
+
+/// Whether a solver reports the success of its last solve through info()
+template<typename SolverType, typename = void>
+struct reports_info : std::false_type {};
+
+/// Specialization for solvers with info(), e.g. the iterative solvers
+template<typename SolverType>
+struct reports_info<SolverType, std::void_t<decltype(
+                                  std::declval<const SolverType&>().info())>>
+  : std::true_type {};
+
+/** @brief Propagate uncertainty through the solution of a linear system
+ *
+ *  Differentiating A X = B gives A dX = dB - dA X, so the derivatives of the
+ *  solution with respect to each variable are found by solving with the
+ *  factorization of the mean matrix that was already used for X. The
+ *  right-hand sides of many variables are solved together, as a single
+ *  multi-column solve. The number of variables per solve shrinks as the
+ *  system grows, so the right-hand sides and their solutions stay within a
+ *  few tens of megabytes.
+ *
+ *  For solvers that report their success through info(), e.g. the iterative
+ *  solvers, the derivatives stop at the first solve that fails. Its status is
+ *  stored in @p info and the remaining derivatives are left out.
+ *
+ *  @tparam T The value type of the variables
+ *  @tparam SolverType The type of the factorization of the mean matrix. Must
+ *                     provide `solve` for a dense matrix.
+ *  @tparam AType The type of the coefficient matrix
+ *  @tparam BType The type of the right-hand side
+ *  @param solver The factorization of the mean of @p a
+ *  @param a The coefficient matrix
+ *  @param b The right-hand side
+ *  @param x0 The solution for the mean values
+ *  @param info Where to store the status of a failed derivative solve, if
+ *              not null. Left unchanged if every solve succeeds.
+ *
+ *  @return The solution, where an element depends on every variable of @p a
+ *          and on the variables of its column of @p b
+ *
+ *  @throw std::bad_alloc if there is insufficient memory for the result or
+ *         the intermediates. Strong throw guarantee.
+ */
+template<typename T, typename SolverType, typename AType, typename BType>
+Eigen::Matrix<Uncertain<T>, Eigen::Dynamic, Eigen::Dynamic> implicit_solve(
+  const SolverType& solver, const AType& a, const BType& b,
+  const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& x0,
+  Eigen::ComputationInfo* info = nullptr) {
+    using matrix_t   = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>;
+    using iterator_t = typename jacobian_t<T>::InnerIterator;
+    using setter_t   = Setter<Uncertain<T>>;
+
+    // The most variables whose right-hand sides are solved together, and the
+    // most values held by the right-hand sides and their solutions
+    constexpr Eigen::Index max_block_size   = 64;
+    constexpr Eigen::Index max_block_values = Eigen::Index(1) << 22;
+
+    const Eigen::Index n    = a.rows();
+    const Eigen::Index nrhs = b.cols();
+
+    // Each variable of a block adds n * nrhs values to both rhs and dx
+    const Eigen::Index block_size = std::clamp(
+      max_block_values / std::max<Eigen::Index>(2 * n * nrhs, 1),
+      Eigen::Index(1), max_block_size);
+
+    DependencyIndex<T> index;
+    index.add(a);
+    index.add(b);
+    index.finalize();
+    auto ja = gather_jacobian(a, index);
+    auto jb = gather_jacobian(b, index);
+
+    auto x = certain_matrix(x0);
+
+    const auto nvars = static_cast<Eigen::Index>(index.size());
+    // Whether each column of X depends on each variable of the block
+    std::vector<char> touched(block_size * nrhs);
+    matrix_t rhs;
+    for(Eigen::Index first = 0; first < nvars; first += block_size) {
+        const Eigen::Index nblock = std::min(block_size, nvars - first);
+
+        // Column s * nrhs + j holds column j of dB - dA X for variable s
+        rhs.setZero(n, nblock * nrhs);
+        std::fill(touched.begin(), touched.end(), 0);
+        for(Eigen::Index s = 0; s < nblock; ++s) {
+            auto rhs_v     = rhs.middleCols(s * nrhs, nrhs);
+            auto touched_v = touched.begin() + s * nrhs;
+            for(iterator_t it(ja, first + s); it; ++it) {
+                Eigen::Index i = it.row() % n;
+                Eigen::Index l = it.row() / n;
+                rhs_v.row(i) -= it.value() * x0.row(l);
+                std::fill(touched_v, touched_v + nrhs, 1);
+            }
+            for(iterator_t it(jb, first + s); it; ++it) {
+                Eigen::Index i = it.row() % n;
+                Eigen::Index j = it.row() / n;
+                rhs_v(i, j) += it.value();
+                touched_v[j] = 1;
+            }
+        }
+
+        matrix_t dx = solver.solve(rhs);
+        if constexpr(reports_info<SolverType>::value) {
+            if(solver.info() != Eigen::Success) {
+                if(info != nullptr) *info = solver.info();
+                break;
+            }
+        }
+
+        for(Eigen::Index s = 0; s < nblock; ++s) {
+            const auto& dep =
+              index.variable(static_cast<std::size_t>(first + s));
+            for(Eigen::Index j = 0; j < nrhs; ++j) {
+                if(!touched[s * nrhs + j]) continue;
+                for(Eigen::Index i = 0; i < n; ++i) {
+                    setter_t(x(i, j)).add_dependency(dep,
+                                                     dx(i, s * nrhs + j));
+                }
+            }
+        }
+    }
+
+    update_sds(x);
+    return x;
+}
+
+} // namespace detail_
+
+/** @brief Solve a linear system with Uncertain coefficients
+ *
+ *  Factorizes the mean of @p a once, with partial pivoting, and propagates
+ *  the uncertainty of @p a and @p b through dX = A^-1 (dB - dA X) using the
+ *  same factorization. This costs about as much as solving the system for
+ *  the mean values, whereas running Eigen's decompositions on Uncertain
+ *  values merges dependency maps at every elimination step.
+ *
+ *  @code
+ *  umatrix_t x = sigma::solve(A, b);
+ *  @endcode
+ *
+ *  @tparam AType The type of the coefficient matrix
+ *  @tparam BType The type of the right-hand side, a matrix or a vector
+ *  @param a The coefficient matrix, which must be square and invertible
+ *  @param b The right-hand side
+ *
+ *  @return The solution X of A X = B, with the shape of @p b
+ *
+ *  @throw std::invalid_argument if @p a is not square or does not have as
+ *         many rows as @p b. Strong throw guarantee.
+ *  @throw std::bad_alloc if there is insufficient memory for the result or
+ *         the intermediates. Strong throw guarantee.
+ */
+template<typename AType, typename BType>
+Eigen::Matrix<typename BType::Scalar, Eigen::Dynamic,
+              BType::ColsAtCompileTime>
+solve(const Eigen::MatrixBase<AType>& a, const Eigen::MatrixBase<BType>& b) {
+    using value_t = typename BType::Scalar::value_t;
+
+    SIGMA_TRACE("solve", detail_::total_deps(a) + detail_::total_deps(b));
+
+    if(a.rows() != a.cols()) {
+        throw std::invalid_argument("solve: coefficient matrix is not square");
+    }
+    if(a.rows() != b.rows()) {
+        throw std::invalid_argument("solve: dimensions do not match");
+    }
+
+    auto a0 = detail_::mean_matrix(a.derived());
+    auto b0 = detail_::mean_matrix(b.derived());
+    Eigen::PartialPivLU<decltype(a0)> lu(a0);
+    decltype(b0) x0 = lu.solve(b0);
+
+    return detail_::implicit_solve<value_t>(lu, a.derived(), b.derived(), x0);
+}
+
+} // namespace sigma
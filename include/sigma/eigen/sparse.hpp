@@ -0,0 +1,183 @@
+#pragma once
+#include "sigma/detail_/jacobian.hpp"
+#include "sigma/eigen/solve.hpp"
+#include "sigma/trace.hpp"
+#include "sigma/uncertain.hpp"
+#include <Eigen/IterativeLinearSolvers>
+#include <Eigen/SparseCholesky>
+#include <Eigen/SparseCore>
+#include <stdexcept>
+
+/** @file sparse.hpp
+ *  @brief Sparse linear systems with Uncertain coefficients
+ *
+ *  Eigen::SparseMatrix works with Uncertain elements through the numeric
+ *  traits in eigen_compat.hpp. Running Eigen's sparse solvers on it would
+ *  carry the uncertainty through every elimination step or iteration, so the
+ *  solvers here instead work on the mean values and propagate the
+ *  uncertainty by implicit differentiation.
+ */
+
+namespace sigma {
+
+/** @brief A sparse solver for systems with Uncertain coefficients
+ *
+ *  Wraps an Eigen sparse solver, which factorizes (or, for iterative solvers,
+ *  preconditions) the mean of the coefficient matrix. Each solve finds the
+ *  solution X for the mean values, then the derivatives of X from
+ *  A dX = dB - dA X, reusing the same solver for all of the variables.
+ *
+ *  As with Eigen's solvers, failures are reported through info() rather than
+ *  thrown. For iterative solvers this covers the solves for the derivatives
+ *  as well as the solve for the mean values. Only solving after a failed
+ *  compute() throws, as there is then no factorization to solve with.
+ *
+ *  The derivatives are taken from every stored element of the coefficient
+ *  matrix. Solvers that only read one triangle of a symmetric matrix (e.g.
+ *  SimplicialLDLT) therefore need both triangles to be stored.
+ *
+ *  @code
+ *  Eigen::SparseMatrix<sigma::UDouble> A = ...;
+ *  sigma::SparseLDLT<double> solver(A);
+ *  uvector_t x = solver.solve(b);
+ *  @endcode
+ *
+ *  @tparam SolverType The type of the Eigen solver, which must act on an
+ *                     Eigen::SparseMatrix of floating point values
+ */
+template<typename SolverType>
+class SparseSolver {
+public:
+    /// The value type of the variables
+    using value_t = typename SolverType::Scalar;
+
+    /// The type of the uncertain values
+    using uncertain_t = Uncertain<value_t>;
+
+    /// The type of the coefficient matrix
+    using sparse_matrix_t = Eigen::SparseMatrix<uncertain_t>;
+
+    /// Construct a solver without a coefficient matrix
+    SparseSolver() = default;
+
+    /** @brief Construct a solver for a coefficient matrix
+     *
+     *  @param a The coefficient matrix
+     *
+     *  @throw std::invalid_argument if @p a is not square. Strong throw
+     *         guarantee.
+     *  @throw std::bad_alloc if there is insufficient memory for the copy of
+     *         @p a or the factorization. Strong throw guarantee.
+     */
+    explicit SparseSolver(const sparse_matrix_t& a) { compute(a); }
+
+    /// Not copyable, as the wrapped solver may refer to the mean matrix
+    SparseSolver(const SparseSolver&) = delete;
+
+    /// Not copyable, as the wrapped solver may refer to the mean matrix
+    SparseSolver& operator=(const SparseSolver&) = delete;
+
+    /** @brief Prepare the solver for a coefficient matrix
+     *
+     *  Keeps a copy of @p a, which provides the derivatives of the
+     *  coefficients when solving.
+     *
+     *  @param a The coefficient matrix
+     *
+     *  @return The solver, for chaining
+     *
+     *  @throw std::invalid_argument if @p a is not square. Strong throw
+     *         guarantee.
+     *  @throw std::bad_alloc if there is insufficient memory for the copy of
+     *         @p a or the factorization. Weak throw guarantee.
+     */
+    SparseSolver& compute(const sparse_matrix_t& a) {
+        if(a.rows() != a.cols()) {
+            throw std::invalid_argument(
+              "SparseSolver: coefficient matrix is not square");
+        }
+        m_a_      = a;
+        m_mean_a_ = detail_::mean_matrix(m_a_);
+        m_solver_.compute(m_mean_a_);
+        m_compute_info_ = m_solver_.info();
+        m_info_         = m_compute_info_;
+        return *this;
+    }
+
+    /** @brief Solve the system for a right-hand side
+     *
+     *  If a solve for the mean values or for the derivatives fails, info()
+     *  reports it and the result should not be used.
+     *
+     *  @tparam BType The type of the right-hand side, a matrix or a vector
+     *  @param b The right-hand side
+     *
+     *  @return The solution X of A X = B, with the shape of @p b
+     *
+     *  @throw std::invalid_argument if @p b does not have as many rows as the
+     *         coefficient matrix. Strong throw guarantee.
+     *  @throw std::runtime_error if the last compute() failed, which leaves
+     *         nothing to solve with. Strong throw guarantee.
+     *  @throw std::bad_alloc if there is insufficient memory for the result
+     *         or the intermediates. Strong throw guarantee.
+     */
+    template<typename BType>
+    Eigen::Matrix<uncertain_t, Eigen::Dynamic, BType::ColsAtCompileTime>
+    solve(const Eigen::MatrixBase<BType>& b) const {
+        using matrix_t =
+          Eigen::Matrix<value_t, Eigen::Dynamic, Eigen::Dynamic>;
+
+        SIGMA_TRACE("SparseSolver::solve",
+                    detail_::total_deps(m_a_) + detail_::total_deps(b));
+
+        if(b.rows() != m_a_.rows()) {
+            throw std::invalid_argument(
+              "SparseSolver: dimensions do not match");
+        }
+        if(m_compute_info_ != Eigen::Success) {
+            throw std::runtime_error(
+              "SparseSolver: the coefficient matrix was not factorized");
+        }
+        matrix_t x0 = m_solver_.solve(detail_::mean_matrix(b.derived()));
+        m_info_     = m_solver_.info();
+        return detail_::implicit_solve<value_t>(m_solver_, m_a_, b.derived(),
+                                                x0, &m_info_);
+    }
+
+    /// Whether the last computation or solve, derivatives included, succeeded
+    Eigen::ComputationInfo info() const { return m_info_; }
+
+    /// The wrapped solver, e.g. to set the tolerance of an iterative solver
+    SolverType& solver() { return m_solver_; }
+
+    /// The wrapped solver
+    const SolverType& solver() const { return m_solver_; }
+
+private:
+    /// The coefficient matrix
+    sparse_matrix_t m_a_;
+
+    /// The mean of the coefficient matrix, which the solver refers to
+    Eigen::SparseMatrix<value_t> m_mean_a_;
+
+    /// The solver for the mean values
+    SolverType m_solver_;
+
+    /// The status of the last computation
+    Eigen::ComputationInfo m_compute_info_ = Eigen::Success;
+
+    /// The status of the last computation or solve
+    mutable Eigen::ComputationInfo m_info_ = Eigen::Success;
+};
+
+/// Sparse LDLT factorization of a symmetric positive definite matrix
+template<typename T>
+using SparseLDLT =
+  SparseSolver<Eigen::SimplicialLDLT<Eigen::SparseMatrix<T>>>;
+
+/// Conjugate gradient solver for a symmetric positive definite matrix
+template<typename T>
+using ConjugateGradient = SparseSolver<Eigen::ConjugateGradient<
+  Eigen::SparseMatrix<T>, Eigen::Lower | Eigen::Upper>>;
+
+} // namespace sigma
@@ -0,0 +1,129 @@
+#pragma once
+#include "sigma/independent.hpp"
+#include "sigma/uncertain.hpp"
+#include <Eigen/Dense>
+#include <Eigen/SparseCore>
+#include <cstddef>
+#include <stdexcept>
+
+/** @file views.hpp
+ *  @brief Conversion between matrices of Uncertain and floating point values
+ */
+
+namespace sigma {
+namespace detail_ {
+
+/// Functor returning the mean of an Uncertain value
+template<typename T>
+struct mean_of {
+    /// The mean of @p x
+    T operator()(const Uncertain<T>& x) const { return x.mean(); }
+};
+
+/// Functor returning the standard deviation of an Uncertain value
+template<typename T>
+struct sd_of {
+    /// The standard deviation of @p x
+    T operator()(const Uncertain<T>& x) const { return x.sd(); }
+};
+
+} // namespace detail_
+
+/** @brief The mean values of a matrix of Uncertain values
+ *
+ *  Returns an Eigen expression rather than a new matrix, so it can be used
+ *  directly in floating point expressions without a temporary, e.g.
+ *  `Eigen::VectorXd r = y - sigma::means(fit);`. Like other Eigen
+ *  expressions, it refers to @p m, which must outlive it.
+ *
+ *  @tparam Derived The type of the matrix
+ *  @param m The matrix
+ *
+ *  @return An expression for the mean of each element of @p m
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename Derived>
+auto means(const Eigen::DenseBase<Derived>& m) {
+    using value_t = typename Derived::Scalar::value_t;
+    return m.derived().unaryExpr(detail_::mean_of<value_t>{});
+}
+
+/// @overload
+template<typename Derived>
+auto means(const Eigen::SparseMatrixBase<Derived>& m) {
+    using value_t = typename Derived::Scalar::value_t;
+    return m.derived().unaryExpr(detail_::mean_of<value_t>{});
+}
+
+/** @brief The standard deviations of a matrix of Uncertain values
+ *
+ *  Returns an Eigen expression rather than a new matrix; see means(). The
+ *  standard deviations are the values stored by each element, so no
+ *  dependencies are visited.
+ *
+ *  @tparam Derived The type of the matrix
+ *  @param m The matrix
+ *
+ *  @return An expression for the standard deviation of each element of @p m
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename Derived>
+auto sds(const Eigen::DenseBase<Derived>& m) {
+    using value_t = typename Derived::Scalar::value_t;
+    return m.derived().unaryExpr(detail_::sd_of<value_t>{});
+}
+
+/// @overload
+template<typename Derived>
+auto sds(const Eigen::SparseMatrixBase<Derived>& m) {
+    using value_t = typename Derived::Scalar::value_t;
+    return m.derived().unaryExpr(detail_::sd_of<value_t>{});
+}
+
+/** @brief Create a matrix of independent variables
+ *
+ *  The matrix counterpart of make_independent for pointers: the standard
+ *  deviation cells of all of the elements share a single allocation.
+ *
+ *  @tparam MeanType The type of the matrix of means
+ *  @tparam SdType The type of the matrix of standard deviations
+ *  @param means The mean of each element
+ *  @param sds The standard deviation of each element
+ *
+ *  @return A matrix with the shape of @p means, whose elements are
+ *          independent variables
+ *
+ *  @throw std::invalid_argument if @p means and @p sds differ in shape.
+ *         Strong throw guarantee.
+ *  @throw std::bad_alloc if the storage cannot be allocated. Strong throw
+ *         guarantee.
+ */
+template<typename MeanType, typename SdType>
+Eigen::Matrix<Uncertain<typename MeanType::Scalar>,
+              MeanType::RowsAtCompileTime, MeanType::ColsAtCompileTime>
+make_independent(const Eigen::MatrixBase<MeanType>& means,
+                 const Eigen::MatrixBase<SdType>& sds) {
+    using value_t  = typename MeanType::Scalar;
+    using matrix_t = Eigen::Matrix<value_t, MeanType::RowsAtCompileTime,
+                                   MeanType::ColsAtCompileTime>;
+
+    if(means.rows() != sds.rows() || means.cols() != sds.cols()) {
+        throw std::invalid_argument(
+          "make_independent: means and sds must have the same shape");
+    }
+
+    // Both are read in the (column-major) storage order of the result
+    const matrix_t m = means;
+    const matrix_t s = sds;
+    Eigen::Matrix<Uncertain<value_t>, MeanType::RowsAtCompileTime,
+                  MeanType::ColsAtCompileTime>
+      values(m.rows(), m.cols());
+    detail_::fill_independent(m.data(), s.data(),
+                              static_cast<std::size_t>(m.size()),
+                              values.data());
+    return values;
+}
+
+} // namespace sigma
@@ -5,23 +5,19 @@
  */
 
 #ifdef ENABLE_EIGEN_SUPPORT
+#include "sigma/policies.hpp"
 #include <Eigen/Dense>
 
-// Foward Declaration
-namespace sigma {
-template<typename T>
-class Uncertain;
-} // namespace sigma
-
 /** @def EIGEN_NUMTRAITS(float_type)
  *  @brief Factorization for Eigen::NumTraits Specialization
  */
 #define EIGEN_NUMTRAITS(float_type)                                          \
     /** @brief Numeric traits for Uncertain<float_type> */                   \
-    template<>                                                               \
-    struct NumTraits<sigma::Uncertain<float_type>> : NumTraits<float_type> { \
+    template<typename PolicyType>                                            \
+    struct NumTraits<sigma::Uncertain<float_type, PolicyType>>               \
+      : NumTraits<float_type> {                                              \
         /** The uncertain type */                                            \
-        using Uncertain = sigma::Uncertain<float_type>;                      \
+        using Uncertain = sigma::Uncertain<float_type, PolicyType>;          \
         /** The corresponding real type */                                   \
         using Real = Uncertain;                                              \
         /** The corresponding non-integer type */                            \
@@ -44,14 +40,43 @@ class Uncertain;
 /** @namespace Eigen
  *  @brief The namespace of the Eigen library
  *
- *  Used here to overload the numeric traits struct for Uncertain values
+ *  Used here to overload the numeric and binary operation traits for Uncertain
+ *  values
  */
 namespace Eigen {
 
 EIGEN_NUMTRAITS(float);
 EIGEN_NUMTRAITS(double);
 
+/** @brief Result of mixing Uncertain and floating point values
+ *
+ *  Allows Eigen expressions that combine a matrix of Uncertain values with a
+ *  matrix or scalar of the underlying floating point type, without casting
+ *  the certain operand to Uncertain first.
+ */
+template<typename T, typename P, typename BinaryOp>
+struct ScalarBinaryOpTraits<sigma::Uncertain<T, P>, T, BinaryOp> {
+    /// The type of the result
+    using ReturnType = sigma::Uncertain<T, P>;
+};
+
+/// Result of mixing floating point and Uncertain values
+template<typename T, typename P, typename BinaryOp>
+struct ScalarBinaryOpTraits<T, sigma::Uncertain<T, P>, BinaryOp> {
+    /// The type of the result
+    using ReturnType = sigma::Uncertain<T, P>;
+};
+
 } // namespace Eigen
 
 #undef EIGEN_NUMTRAITS
+
+#include "sigma/eigen/covariance.hpp"
+#include "sigma/eigen/eigh.hpp"
+#include "sigma/eigen/inverse.hpp"
+#include "sigma/eigen/jacobian.hpp"
+#include "sigma/eigen/product.hpp"
+#include "sigma/eigen/solve.hpp"
+#include "sigma/eigen/sparse.hpp"
+#include "sigma/eigen/views.hpp"
 #endif // ENABLE_EIGEN_SUPPORT
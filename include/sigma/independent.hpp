@@ -0,0 +1,120 @@
+#pragma once
+#include "sigma/detail_/cell_allocator.hpp"
+#include "sigma/detail_/setter.hpp"
+#include "sigma/stats.hpp"
+#include "sigma/uncertain.hpp"
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+/** @file independent.hpp
+ *  @brief Bulk creation of independent variables
+ */
+
+namespace sigma {
+
+/** @brief Create many independent variables at once
+ *
+ *  Constructing `Uncertain(mean, sd)` in a loop allocates one standard
+ *  deviation cell (and its control block) per variable. This function instead
+ *  places all of the standard deviation cells in a single contiguous block
+ *  that is shared by the returned variables, so each variable only needs its
+ *  own dependency map node. The block is released once the last value that
+ *  depends on any of the cells is destroyed.
+ *
+ *  @tparam PolicyType How the variables store and propagate their
+ *                     uncertainty, e.g. `make_independent<AdaptiveStorage>`
+ *  @tparam T The value type of the variables
+ *  @param means Pointer to the @p n mean values
+ *  @param sds Pointer to the @p n standard deviations
+ *  @param n The number of variables to create
+ *
+ *  @return A vector of @p n independent variables, where the i-th element has
+ *          mean `means[i]` and standard deviation `sds[i]`
+ *
+ *  @throw std::bad_alloc if the storage cannot be allocated. Strong throw
+ *         guarantee.
+ */
+template<typename PolicyType = Propagate, typename T>
+std::vector<Uncertain<T, PolicyType>> make_independent(const T* means,
+                                                       const T* sds,
+                                                       std::size_t n);
+
+/** @overload
+ *
+ *  @throw std::invalid_argument if @p means and @p sds differ in length.
+ *         Strong throw guarantee.
+ */
+template<typename PolicyType = Propagate, typename T>
+std::vector<Uncertain<T, PolicyType>> make_independent(
+  const std::vector<T>& means, const std::vector<T>& sds);
+
+// -- Out-of-line Definitions --------------------------------------------------
+
+namespace detail_ {
+
+/** @brief Initialize independent variables in existing storage
+ *
+ *  The implementation of make_independent, for containers other than
+ *  std::vector.
+ *
+ *  @tparam T The value type of the variables
+ *  @tparam P The policy of the variables
+ *  @param means Pointer to the @p n mean values
+ *  @param sds Pointer to the @p n standard deviations
+ *  @param n The number of variables to create
+ *  @param values Pointer to @p n default constructed values to initialize
+ *
+ *  @throw std::bad_alloc if the storage cannot be allocated. Weak throw
+ *         guarantee.
+ */
+template<typename T, typename P>
+void fill_independent(const T* means, const T* sds, std::size_t n,
+                      Uncertain<T, P>* values) {
+    using uncertain_t = Uncertain<T, P>;
+
+    if constexpr(!P::propagates) {
+        for(std::size_t i = 0; i < n; ++i) values[i] = uncertain_t(means[i]);
+    } else {
+        using dep_sd_ptr = typename uncertain_t::dep_sd_ptr;
+        using block_t    = std::vector<T, CellAllocator<T>>;
+
+        // One allocation for the control block and one for all of the cells
+        auto cells =
+          std::allocate_shared<block_t>(CellAllocator<T>{}, sds, sds + n);
+        count_allocations(2);
+
+        for(std::size_t i = 0; i < n; ++i) {
+            Setter<uncertain_t> setter(values[i]);
+            setter.update_mean(means[i]);
+            setter.add_dependency(dep_sd_ptr(cells, cells->data() + i),
+                                  T{1.0});
+            setter.update_sd();
+        }
+    }
+}
+
+} // namespace detail_
+
+template<typename PolicyType, typename T>
+std::vector<Uncertain<T, PolicyType>> make_independent(const T* means,
+                                                       const T* sds,
+                                                       std::size_t n) {
+    std::vector<Uncertain<T, PolicyType>> values(n);
+    detail_::fill_independent(means, sds, n, values.data());
+    return values;
+}
+
+template<typename PolicyType, typename T>
+std::vector<Uncertain<T, PolicyType>> make_independent(
+  const std::vector<T>& means, const std::vector<T>& sds) {
+    if(means.size() != sds.size()) {
+        throw std::invalid_argument(
+          "make_independent: means and sds must have the same length");
+    }
+    return make_independent<PolicyType>(means.data(), sds.data(),
+                                        means.size());
+}
+
+} // namespace sigma
@@ -0,0 +1,178 @@
+#pragma once
+#include "sigma/detail_/setter.hpp"
+#include "sigma/dual.hpp"
+#include "sigma/trace.hpp"
+#include "sigma/uncertain.hpp"
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+/** @file lift.hpp
+ *  @brief Propagation of uncertainty through user-defined functions
+ */
+
+namespace sigma {
+namespace detail_ {
+
+/// The value type shared by the Uncertain arguments in @p Args
+template<typename... Args>
+struct lifted_value {
+    using type = void;
+};
+
+/// Recursive case of lifted_value
+template<typename First, typename... Rest>
+struct lifted_value<First, Rest...> {
+    using type =
+      std::conditional_t<is_uncertain_v<First>, std::decay_t<First>,
+                         typename lifted_value<Rest...>::type>;
+};
+
+/** @brief The input slot of each argument
+ *
+ *  Uncertain arguments are numbered consecutively in the order they are
+ *  passed; any other argument is a constant and its slot is unused.
+ *
+ *  @return The slot of every argument
+ */
+template<typename... Args>
+constexpr std::array<std::size_t, sizeof...(Args)> lifted_slots() {
+    constexpr bool uncertain[] = {is_uncertain_v<Args>..., false};
+    std::array<std::size_t, sizeof...(Args)> slots{};
+    std::size_t n = 0;
+    for(std::size_t i = 0; i < sizeof...(Args); ++i) {
+        slots[i] = uncertain[i] ? n++ : 0;
+    }
+    return slots;
+}
+
+/// Seed an argument for evaluation on Dual numbers
+template<typename DualType, typename Arg>
+auto seed(const Arg& arg, std::size_t slot) {
+    if constexpr(is_uncertain_v<Arg>) {
+        return DualType::variable(arg.mean(), slot);
+    } else {
+        return arg;
+    }
+}
+
+/// Add the dependencies of an argument, scaled by the derivative of its slot
+template<typename SetterType, typename DualType, typename Arg>
+void merge_lifted(SetterType& setter, const DualType& result, const Arg& arg,
+                  std::size_t slot) {
+    if constexpr(is_uncertain_v<Arg>) {
+        setter.update_derivatives(arg.deps(), result.derivative(slot), false);
+    }
+}
+
+} // namespace detail_
+
+/** @brief A user function lifted to act on Uncertain values
+ *
+ *  Calling an instance evaluates the wrapped function once, on Dual numbers
+ *  seeded from the means of the Uncertain arguments, which yields the exact
+ *  partial derivatives with respect to each of them. The dependencies of the
+ *  arguments are then merged into the result in a single pass. This is much
+ *  cheaper than composing the individual operations, which each build an
+ *  intermediate dependency map.
+ *
+ *  @tparam FunctionType The type of the wrapped callable. It must accept Dual
+ *                       arguments in place of the Uncertain ones.
+ */
+template<typename FunctionType>
+class Lifted {
+public:
+    /** @brief Wrap a function
+     *
+     *  @param f The function to wrap
+     *
+     *  @throws Any exception thrown while copying @p f. Same throw guarantee.
+     */
+    explicit Lifted(FunctionType f) : m_f_(std::move(f)) {}
+
+    /** @brief Evaluate the function
+     *
+     *  Arguments that are not Uncertain are forwarded unchanged and treated
+     *  as constants. At least one argument must be Uncertain, and all of the
+     *  Uncertain arguments must share a value type and policy.
+     *
+     *  @tparam Args The types of the arguments
+     *  @param args The arguments to the function
+     *
+     *  @return The value of the function with the uncertainty propagated from
+     *          the Uncertain arguments
+     *
+     *  @throws Any exception thrown by the wrapped function. Same throw
+     *          guarantee.
+     */
+    template<typename... Args>
+    auto operator()(const Args&... args) const {
+        using uncertain_t = typename detail_::lifted_value<Args...>::type;
+        static_assert(!std::is_void_v<uncertain_t>,
+                      "lift: at least one argument must be Uncertain");
+        static_assert(((!detail_::is_uncertain_v<Args> ||
+                        std::is_same_v<std::decay_t<Args>, uncertain_t>)&&...),
+                      "lift: Uncertain arguments must share a value type "
+                      "and policy");
+
+        using value_t                 = typename uncertain_t::value_t;
+        constexpr std::size_t n_slots = (detail_::is_uncertain_v<Args> + ...);
+        using dual_t                  = Dual<value_t, n_slots>;
+        constexpr auto slots          = detail_::lifted_slots<Args...>();
+
+        SIGMA_TRACE_OP("lift", args...);
+
+        return evaluate<uncertain_t, dual_t>(
+          slots, std::index_sequence_for<Args...>{}, args...);
+    }
+
+private:
+    /// Evaluate on Dual numbers and merge the dependencies of the arguments
+    template<typename UncertainType, typename DualType, std::size_t... Is,
+             typename... Args>
+    UncertainType evaluate(const std::array<std::size_t, sizeof...(Is)>& slots,
+                           std::index_sequence<Is...>,
+                           const Args&... args) const {
+        auto result = m_f_(detail_::seed<DualType>(args, slots[Is])...);
+
+        if constexpr(std::is_arithmetic_v<decltype(result)>) {
+            // The function does not depend on its arguments
+            return UncertainType(result);
+        } else {
+            UncertainType c(result.value());
+            detail_::Setter<UncertainType> setter(c);
+            (detail_::merge_lifted(setter, result, args, slots[Is]), ...);
+            setter.update_sd();
+            return c;
+        }
+    }
+
+    /// The wrapped function
+    FunctionType m_f_;
+};
+
+/** @brief Lift a function so that it propagates uncertainty
+ *
+ *  The function must be generic enough to be called with sigma::Dual in place
+ *  of each Uncertain argument, e.g. a generic lambda using the arithmetic
+ *  operators and the math functions of the `sigma` namespace.
+ *
+ *  @code
+ *  auto f = sigma::lift([](auto x, auto y) { return x * sigma::exp(y); });
+ *  sigma::UDouble z = f(a, b);
+ *  @endcode
+ *
+ *  @tparam FunctionType The type of the function
+ *  @param f The function to lift
+ *
+ *  @return A callable that accepts Uncertain arguments
+ *
+ *  @throws Any exception thrown while copying @p f. Same throw guarantee.
+ */
+template<typename FunctionType>
+Lifted<std::decay_t<FunctionType>> lift(FunctionType&& f) {
+    return Lifted<std::decay_t<FunctionType>>(std::forward<FunctionType>(f));
+}
+
+} // namespace sigma
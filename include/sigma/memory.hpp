@@ -0,0 +1,160 @@
+#pragma once
+#include "sigma/detail_/cell_allocator.hpp"
+#include "sigma/detail_/footprint.hpp"
+#include "sigma/uncertain.hpp"
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <set>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+
+/** @file memory.hpp
+ *  @brief Estimates of the memory held by Uncertain values
+ */
+
+namespace sigma {
+
+/** @brief The memory held by the dependencies of a set of values
+ *
+ *  The sizes are estimates from the layout of the dependency containers of
+ *  each storage policy, and do not include any overhead of the allocator
+ *  itself.
+ */
+struct MemoryUsage {
+    /// The number of dependency entries, counting each value's separately
+    std::size_t n_entries = 0;
+
+    /// The number of distinct independent variables depended on
+    std::size_t n_variables = 0;
+
+    /// Bytes in the dependency containers of the values
+    std::size_t deps_bytes = 0;
+
+    /// Bytes in the shared standard deviation cells and their control blocks,
+    /// each counted once however many values share them
+    std::size_t cells_bytes = 0;
+
+    /// The total number of bytes
+    std::size_t total_bytes() const { return deps_bytes + cells_bytes; }
+};
+
+namespace detail_ {
+
+/** @brief The estimated size of the control block of a shared cell
+ *
+ *  A virtual table pointer and the use and weak counts.
+ */
+inline constexpr std::size_t control_block_bytes = sizeof(void*) + 2 * 4;
+
+/** @brief Accumulates the memory of values, counting shared cells once
+ *
+ *  @tparam T The value type of the variables
+ *  @tparam P The propagation policy of the variables
+ */
+template<typename T, typename P>
+class MemoryCounter {
+public:
+    /** @brief Add the dependencies of a value
+     *
+     *  @param x The value
+     *
+     *  @throw std::bad_alloc if the bookkeeping cannot grow. Strong throw
+     *         guarantee.
+     */
+    void add(const Uncertain<T, P>& x) {
+        m_usage_.n_entries += x.deps().size();
+        m_usage_.deps_bytes += deps_bytes(x.deps());
+        for(const auto& [dep, deriv] : x.deps()) {
+            if(m_cells_.insert(dep.get()).second) {
+                ++m_usage_.n_variables;
+                m_usage_.cells_bytes += sizeof(T);
+                // Cells made together share one control block
+                if(m_owners_.insert(dep).second) {
+                    m_usage_.cells_bytes += control_block_bytes;
+                }
+            }
+        }
+    }
+
+    /// The memory of the values added so far
+    const MemoryUsage& usage() const { return m_usage_; }
+
+private:
+    /// The result
+    MemoryUsage m_usage_;
+
+    /// The cells already counted
+    std::unordered_set<const T*> m_cells_;
+
+    /// The control blocks already counted
+    std::set<typename Uncertain<T, P>::dep_sd_ptr, std::owner_less<>>
+      m_owners_;
+};
+
+} // namespace detail_
+
+/** @brief The memory held by the dependencies of a value
+ *
+ *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
+ *  @param x The value
+ *
+ *  @return The estimated memory of the dependency map of @p x and of the
+ *          cells of the variables it depends on
+ *
+ *  @throw std::bad_alloc if the bookkeeping cannot be allocated. Strong throw
+ *         guarantee.
+ */
+template<typename T, typename P>
+MemoryUsage memory_usage(const Uncertain<T, P>& x) {
+    detail_::MemoryCounter<T, P> counter;
+    counter.add(x);
+    return counter.usage();
+}
+
+/** @brief The memory held by the dependencies of a range of values
+ *
+ *  Cells shared by several values, e.g. a variable most of the values depend
+ *  on, are counted once. An Eigen matrix can be passed as `m.reshaped()`.
+ *
+ *  @code
+ *  std::vector<sigma::UDouble> results = model(inputs);
+ *  std::size_t bytes = sigma::memory_usage(results).total_bytes();
+ *  @endcode
+ *
+ *  @tparam RangeType The type of the range, whose elements are Uncertain
+ *  @param range The values
+ *
+ *  @return The estimated memory of the dependency maps of the values and of
+ *          the cells of the variables they depend on
+ *
+ *  @throw std::bad_alloc if the bookkeeping cannot be allocated. Strong throw
+ *         guarantee.
+ */
+template<typename RangeType,
+         typename = decltype(std::begin(std::declval<const RangeType&>()))>
+MemoryUsage memory_usage(const RangeType& range) {
+    using uncertain_t = std::decay_t<decltype(*std::begin(range))>;
+    using value_t     = typename uncertain_t::value_t;
+    detail_::MemoryCounter<value_t, typename uncertain_t::policy_t> counter;
+    for(const auto& x : range) counter.add(x);
+    return counter.usage();
+}
+
+/** @brief The number of independent variables currently alive
+ *
+ *  An independent variable lives as long as any value depends on it, so this
+ *  gauge grows when values that are no longer needed are kept around. It
+ *  counts the variables of every value type, across all threads.
+ *
+ *  @return The number of live independent variables
+ *
+ *  @throw none No throw guarantee
+ */
+inline std::size_t live_independent_variables() {
+    return detail_::live_cells().load(std::memory_order_relaxed);
+}
+
+} // namespace sigma
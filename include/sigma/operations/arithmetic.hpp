@@ -10,18 +10,20 @@ namespace sigma {
 /** @brief Negation Operation
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param a The variable being negated
  *
  *  @return A copy of @p a, but with the sign of the mean reversed
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> operator-(const Uncertain<T>& a);
+template<typename T, typename P>
+Uncertain<T, P> operator-(const Uncertain<T, P>& a);
 
 /** @brief Addition Operation
  *
  *  @tparam T The value type of the variables
+ *  @tparam P The propagation policy of the variables
  *  @param lhs The left-hand variable
  *  @param rhs The right-hand variable
  *
@@ -29,18 +31,20 @@ Uncertain<T> operator-(const Uncertain<T>& a);
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> operator+(const Uncertain<T>& lhs, const Uncertain<T>& rhs);
+template<typename T, typename P>
+Uncertain<T, P> operator+(const Uncertain<T, P>& lhs,
+                          const Uncertain<T, P>& rhs);
 /** @overload */
-template<typename T>
-Uncertain<T> operator+(const Uncertain<T>& lhs, double rhs);
+template<typename T, typename P>
+Uncertain<T, P> operator+(const Uncertain<T, P>& lhs, double rhs);
 /** @overload */
-template<typename T>
-Uncertain<T> operator+(double lhs, const Uncertain<T>& rhs);
+template<typename T, typename P>
+Uncertain<T, P> operator+(double lhs, const Uncertain<T, P>& rhs);
 
 /** @brief Inplace Addition Operation
  *
  *  @tparam T The value type of the variables
+ *  @tparam P The propagation policy of the variables
  *  @param lhs The left-hand variable being modified
  *  @param rhs The right-hand variable
  *
@@ -48,15 +52,16 @@ Uncertain<T> operator+(double lhs, const Uncertain<T>& rhs);
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T>& operator+=(Uncertain<T>& lhs, const Uncertain<T>& rhs);
+template<typename T, typename P>
+Uncertain<T, P>& operator+=(Uncertain<T, P>& lhs, const Uncertain<T, P>& rhs);
 /** @overload */
-template<typename T>
-Uncertain<T>& operator+=(Uncertain<T>& lhs, double rhs);
+template<typename T, typename P>
+Uncertain<T, P>& operator+=(Uncertain<T, P>& lhs, double rhs);
 
 /** @brief Subtraction Operation
  *
  *  @tparam T The value type of the variables
+ *  @tparam P The propagation policy of the variables
  *  @param lhs The left-hand variable
  *  @param rhs The right-hand variable
  *
@@ -64,18 +69,20 @@ Uncertain<T>& operator+=(Uncertain<T>& lhs, double rhs);
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> operator-(const Uncertain<T>& lhs, const Uncertain<T>& rhs);
+template<typename T, typename P>
+Uncertain<T, P> operator-(const Uncertain<T, P>& lhs,
+                          const Uncertain<T, P>& rhs);
 /** @overload */
-template<typename T>
-Uncertain<T> operator-(const Uncertain<T>& lhs, double rhs);
+template<typename T, typename P>
+Uncertain<T, P> operator-(const Uncertain<T, P>& lhs, double rhs);
 /** @overload */
-template<typename T>
-Uncertain<T> operator-(double lhs, const Uncertain<T>& rhs);
+template<typename T, typename P>
+Uncertain<T, P> operator-(double lhs, const Uncertain<T, P>& rhs);
 
 /** @brief Inplace Subtraction Operation
  *
  *  @tparam T The value type of the variables
+ *  @tparam P The propagation policy of the variables
  *  @param lhs The left-hand variable being modified
  *  @param rhs The right-hand variable
  *
@@ -83,15 +90,16 @@ Uncertain<T> operator-(double lhs, const Uncertain<T>& rhs);
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T>& operator-=(Uncertain<T>& lhs, const Uncertain<T>& rhs);
+template<typename T, typename P>
+Uncertain<T, P>& operator-=(Uncertain<T, P>& lhs, const Uncertain<T, P>& rhs);
 /** @overload */
-template<typename T>
-Uncertain<T>& operator-=(Uncertain<T>& lhs, double rhs);
+template<typename T, typename P>
+Uncertain<T, P>& operator-=(Uncertain<T, P>& lhs, double rhs);
 
 /** @brief Multiplication Operation
  *
  *  @tparam T The value type of the variables
+ *  @tparam P The propagation policy of the variables
  *  @param lhs The left-hand variable
  *  @param rhs The right-hand variable
  *
@@ -99,18 +107,20 @@ Uncertain<T>& operator-=(Uncertain<T>& lhs, double rhs);
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> operator*(const Uncertain<T>& lhs, const Uncertain<T>& rhs);
+template<typename T, typename P>
+Uncertain<T, P> operator*(const Uncertain<T, P>& lhs,
+                          const Uncertain<T, P>& rhs);
 /** @overload */
-template<typename T>
-Uncertain<T> operator*(const Uncertain<T>& lhs, double rhs);
+template<typename T, typename P>
+Uncertain<T, P> operator*(const Uncertain<T, P>& lhs, double rhs);
 /** @overload */
-template<typename T>
-Uncertain<T> operator*(double lhs, const Uncertain<T>& rhs);
+template<typename T, typename P>
+Uncertain<T, P> operator*(double lhs, const Uncertain<T, P>& rhs);
 
 /** @brief Inplace Multiplication Operation
  *
  *  @tparam T The value type of the variables
+ *  @tparam P The propagation policy of the variables
  *  @param lhs The left-hand variable being modified
  *  @param rhs The right-hand variable
  *
@@ -118,15 +128,16 @@ Uncertain<T> operator*(double lhs, const Uncertain<T>& rhs);
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T>& operator*=(Uncertain<T>& lhs, const Uncertain<T>& rhs);
+template<typename T, typename P>
+Uncertain<T, P>& operator*=(Uncertain<T, P>& lhs, const Uncertain<T, P>& rhs);
 /** @overload */
-template<typename T>
-Uncertain<T>& operator*=(Uncertain<T>& lhs, double rhs);
+template<typename T, typename P>
+Uncertain<T, P>& operator*=(Uncertain<T, P>& lhs, double rhs);
 
 /** @brief Division Operation
  *
  *  @tparam T The value type of the variables
+ *  @tparam P The propagation policy of the variables
  *  @param lhs The left-hand variable
  *  @param rhs The right-hand variable
  *
@@ -134,18 +145,20 @@ Uncertain<T>& operator*=(Uncertain<T>& lhs, double rhs);
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> operator/(const Uncertain<T>& lhs, const Uncertain<T>& rhs);
+template<typename T, typename P>
+Uncertain<T, P> operator/(const Uncertain<T, P>& lhs,
+                          const Uncertain<T, P>& rhs);
 /** @overload */
-template<typename T>
-Uncertain<T> operator/(double lhs, const Uncertain<T>& rhs);
+template<typename T, typename P>
+Uncertain<T, P> operator/(double lhs, const Uncertain<T, P>& rhs);
 /** @overload */
-template<typename T>
-Uncertain<T> operator/(const Uncertain<T>& lhs, double rhs);
+template<typename T, typename P>
+Uncertain<T, P> operator/(const Uncertain<T, P>& lhs, double rhs);
 
 /** @brief Inplace Division Operation
  *
  *  @tparam T The value type of the variables
+ *  @tparam P The propagation policy of the variables
  *  @param lhs The left-hand variable being modified
  *  @param rhs The right-hand variable
  *
@@ -153,11 +166,11 @@ Uncertain<T> operator/(const Uncertain<T>& lhs, double rhs);
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T>& operator/=(Uncertain<T>& lhs, const Uncertain<T>& rhs);
+template<typename T, typename P>
+Uncertain<T, P>& operator/=(Uncertain<T, P>& lhs, const Uncertain<T, P>& rhs);
 /** @overload */
-template<typename T>
-Uncertain<T>& operator/=(Uncertain<T>& lhs, double rhs);
+template<typename T, typename P>
+Uncertain<T, P>& operator/=(Uncertain<T, P>& lhs, double rhs);
 
 } // namespace sigma
 
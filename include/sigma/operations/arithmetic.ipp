@@ -4,36 +4,42 @@
 
 namespace sigma {
 
-template<typename T>
-Uncertain<T> operator-(const Uncertain<T>& a) {
+template<typename T, typename P>
+Uncertain<T, P> operator-(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("operator-", a);
     T mean = -a.mean();
     T dcda = -1.0;
     return detail_::unary_result(a, mean, dcda);
 }
 
-template<typename T>
-Uncertain<T> operator+(const Uncertain<T>& lhs, const Uncertain<T>& rhs) {
-    Uncertain<T> c(lhs);
+template<typename T, typename P>
+Uncertain<T, P> operator+(const Uncertain<T, P>& lhs,
+                          const Uncertain<T, P>& rhs) {
+    SIGMA_TRACE_OP("operator+", lhs, rhs);
+    Uncertain<T, P> c(lhs);
     c += rhs;
     return c;
 }
 
-template<typename T>
-Uncertain<T> operator+(const Uncertain<T>& lhs, double rhs) {
-    Uncertain<T> c(lhs);
+template<typename T, typename P>
+Uncertain<T, P> operator+(const Uncertain<T, P>& lhs, double rhs) {
+    SIGMA_TRACE_OP("operator+", lhs);
+    Uncertain<T, P> c(lhs);
     c += rhs;
     return c;
 }
 
-template<typename T>
-Uncertain<T> operator+(double lhs, const Uncertain<T>& rhs) {
-    Uncertain<T> c(rhs);
+template<typename T, typename P>
+Uncertain<T, P> operator+(double lhs, const Uncertain<T, P>& rhs) {
+    SIGMA_TRACE_OP("operator+", rhs);
+    Uncertain<T, P> c(rhs);
     c += lhs;
     return c;
 }
 
-template<typename T>
-Uncertain<T>& operator+=(Uncertain<T>& lhs, const Uncertain<T>& rhs) {
+template<typename T, typename P>
+Uncertain<T, P>& operator+=(Uncertain<T, P>& lhs, const Uncertain<T, P>& rhs) {
+    SIGMA_TRACE_OP("operator+=", lhs, rhs);
     T mean = lhs.mean() + rhs.mean();
     T dcda = 1.0;
     T dcdb = 1.0;
@@ -41,37 +47,43 @@ Uncertain<T>& operator+=(Uncertain<T>& lhs, const Uncertain<T>& rhs) {
     return lhs;
 }
 
-template<typename T>
-Uncertain<T>& operator+=(Uncertain<T>& lhs, double rhs) {
+template<typename T, typename P>
+Uncertain<T, P>& operator+=(Uncertain<T, P>& lhs, double rhs) {
+    SIGMA_TRACE_OP("operator+=", lhs);
     T mean = lhs.mean() + rhs;
     T dcda = 1.0;
     detail_::inplace_unary(lhs, mean, dcda);
     return lhs;
 }
 
-template<typename T>
-Uncertain<T> operator-(const Uncertain<T>& lhs, const Uncertain<T>& rhs) {
-    Uncertain<T> c(lhs);
+template<typename T, typename P>
+Uncertain<T, P> operator-(const Uncertain<T, P>& lhs,
+                          const Uncertain<T, P>& rhs) {
+    SIGMA_TRACE_OP("operator-", lhs, rhs);
+    Uncertain<T, P> c(lhs);
     c -= rhs;
     return c;
 }
 
-template<typename T>
-Uncertain<T> operator-(const Uncertain<T>& lhs, double rhs) {
-    Uncertain<T> c(lhs);
+template<typename T, typename P>
+Uncertain<T, P> operator-(const Uncertain<T, P>& lhs, double rhs) {
+    SIGMA_TRACE_OP("operator-", lhs);
+    Uncertain<T, P> c(lhs);
     c -= rhs;
     return c;
 }
 
-template<typename T>
-Uncertain<T> operator-(double lhs, const Uncertain<T>& rhs) {
+template<typename T, typename P>
+Uncertain<T, P> operator-(double lhs, const Uncertain<T, P>& rhs) {
+    SIGMA_TRACE_OP("operator-", rhs);
     T mean = lhs - rhs.mean();
     T dcda = -1.0;
     return detail_::unary_result(rhs, mean, dcda);
 }
 
-template<typename T>
-Uncertain<T>& operator-=(Uncertain<T>& lhs, const Uncertain<T>& rhs) {
+template<typename T, typename P>
+Uncertain<T, P>& operator-=(Uncertain<T, P>& lhs, const Uncertain<T, P>& rhs) {
+    SIGMA_TRACE_OP("operator-=", lhs, rhs);
     T mean = lhs.mean() - rhs.mean();
     T dcda = 1.0;
     T dcdb = -1.0;
@@ -79,35 +91,41 @@ Uncertain<T>& operator-=(Uncertain<T>& lhs, const Uncertain<T>& rhs) {
     return lhs;
 }
 
-template<typename T>
-Uncertain<T>& operator-=(Uncertain<T>& lhs, double rhs) {
+template<typename T, typename P>
+Uncertain<T, P>& operator-=(Uncertain<T, P>& lhs, double rhs) {
+    SIGMA_TRACE_OP("operator-=", lhs);
     T mean = lhs.mean() - rhs;
     T dcda = 1.0;
     detail_::inplace_unary(lhs, mean, dcda);
     return lhs;
 }
 
-template<typename T>
-Uncertain<T> operator*(const Uncertain<T>& lhs, const Uncertain<T>& rhs) {
-    Uncertain<T> c(lhs);
+template<typename T, typename P>
+Uncertain<T, P> operator*(const Uncertain<T, P>& lhs,
+                          const Uncertain<T, P>& rhs) {
+    SIGMA_TRACE_OP("operator*", lhs, rhs);
+    Uncertain<T, P> c(lhs);
     c *= rhs;
     return c;
 }
 
-template<typename T>
-Uncertain<T> operator*(const Uncertain<T>& lhs, double rhs) {
-    Uncertain<T> c(lhs);
+template<typename T, typename P>
+Uncertain<T, P> operator*(const Uncertain<T, P>& lhs, double rhs) {
+    SIGMA_TRACE_OP("operator*", lhs);
+    Uncertain<T, P> c(lhs);
     c *= rhs;
     return c;
 }
 
-template<typename T>
-Uncertain<T> operator*(double lhs, const Uncertain<T>& rhs) {
+template<typename T, typename P>
+Uncertain<T, P> operator*(double lhs, const Uncertain<T, P>& rhs) {
+    SIGMA_TRACE_OP("operator*", rhs);
     return rhs * lhs;
 }
 
-template<typename T>
-Uncertain<T>& operator*=(Uncertain<T>& lhs, const Uncertain<T>& rhs) {
+template<typename T, typename P>
+Uncertain<T, P>& operator*=(Uncertain<T, P>& lhs, const Uncertain<T, P>& rhs) {
+    SIGMA_TRACE_OP("operator*=", lhs, rhs);
     T mean = lhs.mean() * rhs.mean();
     T dcda = rhs.mean();
     T dcdb = lhs.mean();
@@ -115,37 +133,43 @@ Uncertain<T>& operator*=(Uncertain<T>& lhs, const Uncertain<T>& rhs) {
     return lhs;
 }
 
-template<typename T>
-Uncertain<T>& operator*=(Uncertain<T>& lhs, double rhs) {
+template<typename T, typename P>
+Uncertain<T, P>& operator*=(Uncertain<T, P>& lhs, double rhs) {
+    SIGMA_TRACE_OP("operator*=", lhs);
     T mean = lhs.mean() * rhs;
     T dcda = rhs;
     detail_::inplace_unary(lhs, mean, dcda);
     return lhs;
 }
 
-template<typename T>
-Uncertain<T> operator/(const Uncertain<T>& lhs, const Uncertain<T>& rhs) {
-    Uncertain<T> c(lhs);
+template<typename T, typename P>
+Uncertain<T, P> operator/(const Uncertain<T, P>& lhs,
+                          const Uncertain<T, P>& rhs) {
+    SIGMA_TRACE_OP("operator/", lhs, rhs);
+    Uncertain<T, P> c(lhs);
     c /= rhs;
     return c;
 }
 
-template<typename T>
-Uncertain<T> operator/(const Uncertain<T>& lhs, double rhs) {
-    Uncertain<T> c(lhs);
+template<typename T, typename P>
+Uncertain<T, P> operator/(const Uncertain<T, P>& lhs, double rhs) {
+    SIGMA_TRACE_OP("operator/", lhs);
+    Uncertain<T, P> c(lhs);
     c /= rhs;
     return c;
 }
 
-template<typename T>
-Uncertain<T> operator/(double lhs, const Uncertain<T>& rhs) {
+template<typename T, typename P>
+Uncertain<T, P> operator/(double lhs, const Uncertain<T, P>& rhs) {
+    SIGMA_TRACE_OP("operator/", rhs);
     T mean = lhs / rhs.mean();
     T dcda = -lhs / std::pow(rhs.mean(), 2.0);
     return detail_::unary_result(rhs, mean, dcda);
 }
 
-template<typename T>
-Uncertain<T>& operator/=(Uncertain<T>& lhs, const Uncertain<T>& rhs) {
+template<typename T, typename P>
+Uncertain<T, P>& operator/=(Uncertain<T, P>& lhs, const Uncertain<T, P>& rhs) {
+    SIGMA_TRACE_OP("operator/=", lhs, rhs);
     T mean = lhs.mean() / rhs.mean();
     T dcda = 1.0 / rhs.mean();
     T dcdb = -lhs.mean() / std::pow(rhs.mean(), 2.0);
@@ -153,8 +177,9 @@ Uncertain<T>& operator/=(Uncertain<T>& lhs, const Uncertain<T>& rhs) {
     return lhs;
 }
 
-template<typename T>
-Uncertain<T>& operator/=(Uncertain<T>& lhs, double rhs) {
+template<typename T, typename P>
+Uncertain<T, P>& operator/=(Uncertain<T, P>& lhs, double rhs) {
+    SIGMA_TRACE_OP("operator/=", lhs);
     T mean = lhs.mean() / rhs;
     T dcda = 1.0 / rhs;
     detail_::inplace_unary(lhs, mean, dcda);
@@ -10,70 +10,76 @@ namespace sigma {
 /** @brief Absolute Value
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param a The variable
  *
  *  @return The absolute value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> abs(const Uncertain<T>& a);
+template<typename T, typename P>
+Uncertain<T, P> abs(const Uncertain<T, P>& a);
 
 /** @brief Absolute Value
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param a The variable
  *
  *  @return The absolute value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> fabs(const Uncertain<T>& a);
+template<typename T, typename P>
+Uncertain<T, P> fabs(const Uncertain<T, P>& a);
 
 /** @brief The Square of the Absolute Value
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param a The variable
  *
  *  @return The square of the absolute value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> abs2(const Uncertain<T>& a);
+template<typename T, typename P>
+Uncertain<T, P> abs2(const Uncertain<T, P>& a);
 
 /** @brief Nearest integer not less than the given value
  *
- *  Note that this returns an Uncertain<T> value with no dependencies
+ *  Note that this returns an Uncertain<T, P> value with no dependencies
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param a The variable
  *
  *  @return The nearest integer not greater than @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> ceil(const Uncertain<T>& a);
+template<typename T, typename P>
+Uncertain<T, P> ceil(const Uncertain<T, P>& a);
 
 /** @brief Nearest integer not greater than the given value
  *
- *  Note that this returns an Uncertain<T> value with no dependencies
+ *  Note that this returns an Uncertain<T, P> value with no dependencies
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param a The variable
  *
  *  @return The nearest integer not greater than @p u
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> floor(const Uncertain<T>& a);
+template<typename T, typename P>
+Uncertain<T, P> floor(const Uncertain<T, P>& a);
 
 /** @brief Floating point module
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param a The first variable
  *  @param b The first variable
  *
@@ -81,18 +87,19 @@ Uncertain<T> floor(const Uncertain<T>& a);
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> fmod(const Uncertain<T>& a, const Uncertain<T>& b);
+template<typename T, typename P>
+Uncertain<T, P> fmod(const Uncertain<T, P>& a, const Uncertain<T, P>& b);
 /** @overload */
-template<typename T>
-Uncertain<T> fmod(const Uncertain<T>& a, double b);
+template<typename T, typename P>
+Uncertain<T, P> fmod(const Uncertain<T, P>& a, double b);
 /** @overload */
-template<typename T>
-Uncertain<T> fmod(double a, const Uncertain<T>& b);
+template<typename T, typename P>
+Uncertain<T, P> fmod(double a, const Uncertain<T, P>& b);
 
 /** @brief Copy the sign of one value to another
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param a The variable whose magnitude is copied
  *  @param b The variable whose sign is copied
  *
@@ -100,12 +107,13 @@ Uncertain<T> fmod(double a, const Uncertain<T>& b);
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> copysign(const Uncertain<T>& a, const Uncertain<T>& b);
+template<typename T, typename P>
+Uncertain<T, P> copysign(const Uncertain<T, P>& a, const Uncertain<T, P>& b);
 
 /** @brief Copy the sign of one value to another
  *
  *  @tparam T The value type of @p a
+ *  @tparam P The propagation policy of the variable
  *  @tparam U The numeric type of @p b
  *  @param a The variable whose magnitude is copied
  *  @param b The variable whose sign is copied
@@ -114,12 +122,13 @@ Uncertain<T> copysign(const Uncertain<T>& a, const Uncertain<T>& b);
  *
  *  @throw none No throw guarantee
  */
-template<typename T, typename U>
-Uncertain<T> copysign(const Uncertain<T>& a, const U& b);
+template<typename T, typename P, typename U>
+Uncertain<T, P> copysign(const Uncertain<T, P>& a, const U& b);
 
 /** @brief Copy the sign of one value to another
  *
  *  @tparam T The value type of @p b
+ *  @tparam P The propagation policy of the variable
  *  @tparam U The numeric type of @p a
  *  @param a The variable whose magnitude is copied
  *  @param b The variable whose sign is copied
@@ -128,32 +137,34 @@ Uncertain<T> copysign(const Uncertain<T>& a, const U& b);
  *
  *  @throw none No throw guarantee
  */
-template<typename T, typename U>
-U copysign(const U& a, const Uncertain<T>& b);
+template<typename T, typename P, typename U>
+U copysign(const U& a, const Uncertain<T, P>& b);
 
 /** @brief Remove the fractional part from a variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param a The variable whose value is truncated
  *
  *  @return A variable whose value is the truncated value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> trunc(const Uncertain<T>& a);
+template<typename T, typename P>
+Uncertain<T, P> trunc(const Uncertain<T, P>& a);
 
 /** @brief Round to the nearest integar, away from zero in halfway case.
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param a The variable whose value is truncated
  *
  *  @return A variable whose value is the rounded value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> round(const Uncertain<T>& a);
+template<typename T, typename P>
+Uncertain<T, P> round(const Uncertain<T, P>& a);
 
 } // namespace sigma
 
@@ -5,81 +5,102 @@
 
 namespace sigma {
 
-template<typename T>
-Uncertain<T> abs(const Uncertain<T>& a) {
+template<typename T, typename P>
+Uncertain<T, P> abs(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("abs", a);
     T mean = std::abs(a.mean());
     T dcda = (a.mean() >= 0) ? 1.0 : -1.0;
     return detail_::unary_result(a, mean, dcda);
 }
 
-template<typename T>
-Uncertain<T> fabs(const Uncertain<T>& a) {
+template<typename T, typename P>
+Uncertain<T, P> fabs(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("fabs", a);
     return abs(a);
 }
 
-template<typename T>
-Uncertain<T> abs2(const Uncertain<T>& a) {
+template<typename T, typename P>
+Uncertain<T, P> abs2(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("abs2", a);
     return pow(abs(a), 2.0);
 }
 
-template<typename T>
-Uncertain<T> ceil(const Uncertain<T>& a) {
-    return Uncertain<T>(std::ceil(a.mean()));
+template<typename T, typename P>
+Uncertain<T, P> ceil(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("ceil", a);
+    return Uncertain<T, P>(std::ceil(a.mean()));
 }
 
-template<typename T>
-Uncertain<T> floor(const Uncertain<T>& a) {
-    return Uncertain<T>(std::floor(a.mean()));
+template<typename T, typename P>
+Uncertain<T, P> floor(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("floor", a);
+    return Uncertain<T, P>(std::floor(a.mean()));
 }
 
-template<typename T>
-Uncertain<T> fmod(const Uncertain<T>& a, const Uncertain<T>& b) {
+template<typename T, typename P>
+Uncertain<T, P> fmod(const Uncertain<T, P>& a, const Uncertain<T, P>& b) {
+    SIGMA_TRACE_OP("fmod", a, b);
     T mean = std::fmod(a.mean(), b.mean());
-    T dcda = 1.0;
-    T dcdb = -std::floor(a.mean() / b.mean());
-    return detail_::binary_result(a, b, mean, dcda, dcdb);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(mean);
+    } else {
+        T dcda = 1.0;
+        T dcdb = -std::floor(a.mean() / b.mean());
+        return detail_::binary_result(a, b, mean, dcda, dcdb);
+    }
 }
 
-template<typename T>
-Uncertain<T> fmod(const Uncertain<T>& a, double b) {
+template<typename T, typename P>
+Uncertain<T, P> fmod(const Uncertain<T, P>& a, double b) {
+    SIGMA_TRACE_OP("fmod", a);
     T mean = std::fmod(a.mean(), b);
     T dcda = 1.0;
     return detail_::unary_result(a, mean, dcda);
 }
 
-template<typename T>
-Uncertain<T> fmod(double a, const Uncertain<T>& b) {
+template<typename T, typename P>
+Uncertain<T, P> fmod(double a, const Uncertain<T, P>& b) {
+    SIGMA_TRACE_OP("fmod", b);
     T mean = std::fmod(a, b.mean());
-    T dcda = -std::floor(a / b.mean());
-    return detail_::unary_result(b, mean, dcda);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(mean);
+    } else {
+        T dcda = -std::floor(a / b.mean());
+        return detail_::unary_result(b, mean, dcda);
+    }
 }
 
-template<typename T>
-Uncertain<T> copysign(const Uncertain<T>& a, const Uncertain<T>& b) {
+template<typename T, typename P>
+Uncertain<T, P> copysign(const Uncertain<T, P>& a, const Uncertain<T, P>& b) {
+    SIGMA_TRACE_OP("copysign", a, b);
     return copysign(a, b.mean());
 }
 
-template<typename T, typename U>
-Uncertain<T> copysign(const Uncertain<T>& a, const U& b) {
+template<typename T, typename P, typename U>
+Uncertain<T, P> copysign(const Uncertain<T, P>& a, const U& b) {
+    SIGMA_TRACE_OP("copysign", a);
     auto b_sign = std::copysign(1.0, b);
     T mean      = std::copysign(a.mean(), b);
     T dcda      = (a.mean() >= 0) ? b_sign : -b_sign;
     return detail_::unary_result(a, mean, dcda);
 }
 
-template<typename T, typename U>
-U copysign(const U& a, const Uncertain<T>& b) {
+template<typename T, typename P, typename U>
+U copysign(const U& a, const Uncertain<T, P>& b) {
+    SIGMA_TRACE_OP("copysign", b);
     return std::copysign(a, b.mean());
 }
 
-template<typename T>
-Uncertain<T> trunc(const Uncertain<T>& a) {
-    return Uncertain<T>(std::trunc(a.mean()));
+template<typename T, typename P>
+Uncertain<T, P> trunc(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("trunc", a);
+    return Uncertain<T, P>(std::trunc(a.mean()));
 }
 
-template<typename T>
-Uncertain<T> round(const Uncertain<T>& a) {
-    return Uncertain<T>(std::round(a.mean()));
+template<typename T, typename P>
+Uncertain<T, P> round(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("round", a);
+    return Uncertain<T, P>(std::round(a.mean()));
 }
 
 } // namespace sigma
@@ -10,50 +10,54 @@ namespace sigma {
 /** @brief Error function
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param a The variable
  *
  *  @return The error function value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> erf(const Uncertain<T>& a);
+template<typename T, typename P>
+Uncertain<T, P> erf(const Uncertain<T, P>& a);
 
 /** @brief Complementary error function
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param a The variable
  *
  *  @return The complementary error function value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> erfc(const Uncertain<T>& a);
+template<typename T, typename P>
+Uncertain<T, P> erfc(const Uncertain<T, P>& a);
 
 /** @brief Gamma function
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param a The variable
  *
  *  @return The gamma function value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> tgamma(const Uncertain<T>& a);
+template<typename T, typename P>
+Uncertain<T, P> tgamma(const Uncertain<T, P>& a);
 
 /** @brief Gamma function Natural Logarithm
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param a The variable
  *
  *  @return The natural logarithm of the gamma function value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> lgamma(const Uncertain<T>& a);
+template<typename T, typename P>
+Uncertain<T, P> lgamma(const Uncertain<T, P>& a);
 
 } // namespace sigma
 
@@ -1,39 +1,57 @@
 #pragma once
 
+#include "sigma/detail_/math_kernels.hpp"
 #include "sigma/detail_/operation_common.hpp"
+#include "sigma/detail_/special_functions.hpp"
 #include <cmath>
 
 namespace sigma {
 
 // -- Definitions --------------------------------------------------------------
-template<typename T>
-Uncertain<T> erf(const Uncertain<T>& a) {
-    T mean = std::erf(a.mean());
-    T dcda = std::exp(-std::pow(a.mean(), 2)) * (2 / std::sqrt(detail_::pi));
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename P>
+Uncertain<T, P> erf(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("erf", a);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(std::erf(a.mean()));
+    } else {
+        auto [mean, dcda] = detail_::kernels::erf(a.mean());
+        return detail_::unary_result(a, mean, dcda);
+    }
 }
 
-template<typename T>
-Uncertain<T> erfc(const Uncertain<T>& a) {
-    T mean = std::erfc(a.mean());
-    T dcda = -std::exp(-std::pow(a.mean(), 2)) * (2 / std::sqrt(detail_::pi));
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename P>
+Uncertain<T, P> erfc(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("erfc", a);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(std::erfc(a.mean()));
+    } else {
+        auto [mean, dcda] = detail_::kernels::erfc(a.mean());
+        return detail_::unary_result(a, mean, dcda);
+    }
 }
 
-template<typename T>
-Uncertain<T> tgamma(const Uncertain<T>& a) {
-    auto func = [](decltype(a.mean()) x) { return std::tgamma(x); };
-    T mean    = std::tgamma(a.mean());
-    T dcda    = detail_::numeric_derivative(func, a.mean());
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename P>
+Uncertain<T, P> tgamma(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("tgamma", a);
+    T mean = std::tgamma(a.mean());
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(mean);
+    } else {
+        T dcda = mean * detail_::digamma(a.mean());
+        return detail_::unary_result(a, mean, dcda);
+    }
 }
 
-template<typename T>
-Uncertain<T> lgamma(const Uncertain<T>& a) {
-    auto func = [](decltype(a.mean()) x) { return std::lgamma(x); };
-    T mean    = std::lgamma(a.mean());
-    T dcda    = detail_::numeric_derivative(func, a.mean());
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename P>
+Uncertain<T, P> lgamma(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("lgamma", a);
+    T mean = std::lgamma(a.mean());
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(mean);
+    } else {
+        T dcda = detail_::digamma(a.mean());
+        return detail_::unary_result(a, mean, dcda);
+    }
 }
 
 } // namespace sigma
@@ -1,105 +1,159 @@
 #pragma once
 
+#include "sigma/detail_/math_kernels.hpp"
 #include "sigma/detail_/operation_common.hpp"
 #include <cmath>
+#include <tuple>
 
 namespace sigma {
 
-template<typename T, typename U>
-Uncertain<T> pow(const Uncertain<T>& a, const U& exp) {
-    T mean = std::pow(a.mean(), exp);
-    T dcda = exp * std::pow(a.mean(), exp - 1);
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename P, typename U>
+Uncertain<T, P> pow(const Uncertain<T, P>& a, const U& exp) {
+    SIGMA_TRACE_OP("pow", a);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(std::pow(a.mean(), exp));
+    } else {
+        auto [mean, dcda] = detail_::kernels::pow(a.mean(), exp);
+        return detail_::unary_result(a, mean, dcda);
+    }
 }
 
-template<typename T>
-Uncertain<T> pow(const Uncertain<T>& a, const Uncertain<T>& exp) {
-    T mean = std::pow(a.mean(), exp.mean());
-    T dcda = exp.mean() * std::pow(a.mean(), exp.mean() - 1);
-    T dcdb = std::log(a.mean()) * std::pow(a.mean(), exp.mean());
-    return detail_::binary_result(a, exp, mean, dcda, dcdb);
+template<typename T, typename P>
+Uncertain<T, P> pow(const Uncertain<T, P>& a, const Uncertain<T, P>& exp) {
+    SIGMA_TRACE_OP("pow", a, exp);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(std::pow(a.mean(), exp.mean()));
+    } else {
+        auto [mean, dcda, dcdb] =
+          detail_::kernels::pow_binary(a.mean(), exp.mean());
+        return detail_::binary_result(a, exp, mean, dcda, dcdb);
+    }
 }
 
-template<typename T>
-Uncertain<T> sqrt(const Uncertain<T>& a) {
-    T mean = std::sqrt(a.mean());
-    T dcda = 1.0 / (2.0 * std::sqrt(a.mean()));
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename P>
+Uncertain<T, P> sqrt(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("sqrt", a);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(std::sqrt(a.mean()));
+    } else {
+        auto [mean, dcda] = detail_::kernels::sqrt(a.mean());
+        return detail_::unary_result(a, mean, dcda);
+    }
 }
 
-template<typename T>
-Uncertain<T> cbrt(const Uncertain<T>& a) {
-    T mean = std::cbrt(a.mean());
-    T dcda = 1.0 / (3.0 * std::cbrt(std::pow(a.mean(), 2.0)));
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename P>
+Uncertain<T, P> cbrt(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("cbrt", a);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(std::cbrt(a.mean()));
+    } else {
+        auto [mean, dcda] = detail_::kernels::cbrt(a.mean());
+        return detail_::unary_result(a, mean, dcda);
+    }
 }
 
-template<typename T>
-Uncertain<T> exp(const Uncertain<T>& a) {
-    T mean = std::exp(a.mean());
-    T dcda = std::exp(a.mean());
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename P>
+Uncertain<T, P> exp(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("exp", a);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(std::exp(a.mean()));
+    } else {
+        auto [mean, dcda] = detail_::kernels::exp(a.mean());
+        return detail_::unary_result(a, mean, dcda);
+    }
 }
 
-template<typename T>
-Uncertain<T> exp2(const Uncertain<T>& a) {
-    T mean = std::exp2(a.mean());
-    T dcda = mean * std::log(2.0);
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename P>
+Uncertain<T, P> exp2(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("exp2", a);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(std::exp2(a.mean()));
+    } else {
+        auto [mean, dcda] = detail_::kernels::exp2(a.mean());
+        return detail_::unary_result(a, mean, dcda);
+    }
 }
 
-template<typename T>
-Uncertain<T> expm1(const Uncertain<T>& a) {
-    T mean = std::expm1(a.mean());
-    T dcda = std::exp(a.mean());
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename P>
+Uncertain<T, P> expm1(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("expm1", a);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(std::expm1(a.mean()));
+    } else {
+        auto [mean, dcda] = detail_::kernels::expm1(a.mean());
+        return detail_::unary_result(a, mean, dcda);
+    }
 }
 
-template<typename T>
-Uncertain<T> log(const Uncertain<T>& a) {
-    T mean = std::log(a.mean());
-    T dcda = 1.0 / a.mean();
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename P>
+Uncertain<T, P> log(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("log", a);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(std::log(a.mean()));
+    } else {
+        auto [mean, dcda] = detail_::kernels::log(a.mean());
+        return detail_::unary_result(a, mean, dcda);
+    }
 }
 
-template<typename T>
-Uncertain<T> log10(const Uncertain<T>& a) {
-    T mean = std::log10(a.mean());
-    T dcda = 1.0 / (a.mean() * std::log(10.0));
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename P>
+Uncertain<T, P> log10(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("log10", a);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(std::log10(a.mean()));
+    } else {
+        auto [mean, dcda] = detail_::kernels::log10(a.mean());
+        return detail_::unary_result(a, mean, dcda);
+    }
 }
 
-template<typename T>
-Uncertain<T> log2(const Uncertain<T>& a) {
-    T mean = std::log2(a.mean());
-    T dcda = 1.0 / (a.mean() * std::log(2.0));
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename P>
+Uncertain<T, P> log2(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("log2", a);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(std::log2(a.mean()));
+    } else {
+        auto [mean, dcda] = detail_::kernels::log2(a.mean());
+        return detail_::unary_result(a, mean, dcda);
+    }
 }
 
-template<typename T>
-Uncertain<T> log1p(const Uncertain<T>& a) {
-    T mean = std::log1p(a.mean());
-    T dcda = 1.0 / (a.mean() + 1.0);
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename P>
+Uncertain<T, P> log1p(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("log1p", a);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(std::log1p(a.mean()));
+    } else {
+        auto [mean, dcda] = detail_::kernels::log1p(a.mean());
+        return detail_::unary_result(a, mean, dcda);
+    }
 }
 
-template<typename T>
-Uncertain<T> hypot(const Uncertain<T>& a, const Uncertain<T>& b) {
-    T mean = std::hypot(a.mean(), b.mean());
-    T dcda = a.mean() / std::hypot(a.mean(), b.mean());
-    T dcdb = b.mean() / std::hypot(a.mean(), b.mean());
-    return detail_::binary_result(a, b, mean, dcda, dcdb);
+template<typename T, typename P>
+Uncertain<T, P> hypot(const Uncertain<T, P>& a, const Uncertain<T, P>& b) {
+    SIGMA_TRACE_OP("hypot", a, b);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(std::hypot(a.mean(), b.mean()));
+    } else {
+        auto [mean, dcda, dcdb] = detail_::kernels::hypot(a.mean(), b.mean());
+        return detail_::binary_result(a, b, mean, dcda, dcdb);
+    }
 }
 
-template<typename T, typename U>
-Uncertain<T> hypot(const Uncertain<T>& a, const U& b) {
-    T mean = std::hypot(a.mean(), b);
-    T dcda = a.mean() / std::hypot(a.mean(), b);
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename P, typename U>
+Uncertain<T, P> hypot(const Uncertain<T, P>& a, const U& b) {
+    SIGMA_TRACE_OP("hypot", a);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(std::hypot(a.mean(), T(b)));
+    } else {
+        const auto c = detail_::kernels::hypot(a.mean(), T(b));
+        return detail_::unary_result(a, std::get<0>(c), std::get<1>(c));
+    }
 }
 
-template<typename T, typename U>
-Uncertain<T> hypot(const U& a, const Uncertain<T>& b) {
+template<typename T, typename P, typename U>
+Uncertain<T, P> hypot(const U& a, const Uncertain<T, P>& b) {
+    SIGMA_TRACE_OP("hypot", b);
     return hypot(b, a);
 }
 
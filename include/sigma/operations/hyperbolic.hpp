@@ -10,74 +10,80 @@ namespace sigma {
 /** @brief Hyperbolic sine of the variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param a The variable
  *
  *  @return A variable that is the hyperbolic sine value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> sinh(const Uncertain<T>& a);
+template<typename T, typename P>
+Uncertain<T, P> sinh(const Uncertain<T, P>& a);
 
 /** @brief Hyperbolic cosine of the variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param a The variable
  *
  *  @return A variable that is the hyperbolic cosine value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> cosh(const Uncertain<T>& a);
+template<typename T, typename P>
+Uncertain<T, P> cosh(const Uncertain<T, P>& a);
 
 /** @brief Hyperbolic tangent of the variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param a The variable
  *
  *  @return A variable that is the hyperbolic tangent value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> tanh(const Uncertain<T>& a);
+template<typename T, typename P>
+Uncertain<T, P> tanh(const Uncertain<T, P>& a);
 
 /** @brief Hyperbolic arcsine of the variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param a The variable
  *
  *  @return A variable that is the hyperbolic arcsine value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> asinh(const Uncertain<T>& a);
+template<typename T, typename P>
+Uncertain<T, P> asinh(const Uncertain<T, P>& a);
 
 /** @brief Hyperbolic arccosine of the variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param a The variable
  *
  *  @return A variable that is the hyperbolic arccosine value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> acosh(const Uncertain<T>& a);
+template<typename T, typename P>
+Uncertain<T, P> acosh(const Uncertain<T, P>& a);
 
 /** @brief Hyperbolic arctangent of the variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param a The variable
  *
  *  @return A variable that is the hyperbolic arctangent value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> atanh(const Uncertain<T>& a);
+template<typename T, typename P>
+Uncertain<T, P> atanh(const Uncertain<T, P>& a);
 
 } // namespace sigma
 
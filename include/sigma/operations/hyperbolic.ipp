@@ -1,50 +1,75 @@
 #pragma once
 
+#include "sigma/detail_/math_kernels.hpp"
 #include "sigma/detail_/operation_common.hpp"
 #include <cmath>
 
 namespace sigma {
 
-template<typename T>
-Uncertain<T> sinh(const Uncertain<T>& a) {
-    T mean = std::sinh(a.mean());
-    T dcda = std::cosh(a.mean());
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename P>
+Uncertain<T, P> sinh(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("sinh", a);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(std::sinh(a.mean()));
+    } else {
+        auto [mean, dcda] = detail_::kernels::sinh(a.mean());
+        return detail_::unary_result(a, mean, dcda);
+    }
 }
 
-template<typename T>
-Uncertain<T> cosh(const Uncertain<T>& a) {
-    T mean = std::cosh(a.mean());
-    T dcda = std::sinh(a.mean());
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename P>
+Uncertain<T, P> cosh(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("cosh", a);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(std::cosh(a.mean()));
+    } else {
+        auto [mean, dcda] = detail_::kernels::cosh(a.mean());
+        return detail_::unary_result(a, mean, dcda);
+    }
 }
 
-template<typename T>
-Uncertain<T> tanh(const Uncertain<T>& a) {
-    T mean = std::tanh(a.mean());
-    T dcda = 1.0 - std::pow(std::tanh(a.mean()), 2.0);
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename P>
+Uncertain<T, P> tanh(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("tanh", a);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(std::tanh(a.mean()));
+    } else {
+        auto [mean, dcda] = detail_::kernels::tanh(a.mean());
+        return detail_::unary_result(a, mean, dcda);
+    }
 }
 
-template<typename T>
-Uncertain<T> asinh(const Uncertain<T>& a) {
-    T mean = std::asinh(a.mean());
-    T dcda = 1.0 / std::sqrt(1 + std::pow(a.mean(), 2.0));
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename P>
+Uncertain<T, P> asinh(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("asinh", a);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(std::asinh(a.mean()));
+    } else {
+        auto [mean, dcda] = detail_::kernels::asinh(a.mean());
+        return detail_::unary_result(a, mean, dcda);
+    }
 }
 
-template<typename T>
-Uncertain<T> acosh(const Uncertain<T>& a) {
-    T mean = std::acosh(a.mean());
-    T dcda = 1.0 / std::sqrt(std::pow(a.mean(), 2.0) - 1.0);
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename P>
+Uncertain<T, P> acosh(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("acosh", a);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(std::acosh(a.mean()));
+    } else {
+        auto [mean, dcda] = detail_::kernels::acosh(a.mean());
+        return detail_::unary_result(a, mean, dcda);
+    }
 }
 
-template<typename T>
-Uncertain<T> atanh(const Uncertain<T>& a) {
-    T mean = std::atanh(a.mean());
-    T dcda = 1.0 / (1.0 - std::pow(a.mean(), 2.0));
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename P>
+Uncertain<T, P> atanh(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("atanh", a);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(std::atanh(a.mean()));
+    } else {
+        auto [mean, dcda] = detail_::kernels::atanh(a.mean());
+        return detail_::unary_result(a, mean, dcda);
+    }
 }
 
 } // namespace sigma
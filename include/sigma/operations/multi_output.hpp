@@ -0,0 +1,110 @@
+#pragma once
+#include "sigma/uncertain.hpp"
+#include <array>
+#include <utility>
+
+/** @file multi_output.hpp
+ *  @brief Operations with several correlated results
+ *
+ *  Each of these functions evaluates the shared parts of its results once and
+ *  merges the dependencies of its inputs a single time for all of the
+ *  outputs. The results can be unpacked with structured bindings, e.g.
+ *  `auto [s, c] = sigma::sincos(a);`.
+ */
+
+namespace sigma {
+
+/** @brief Sine and cosine of the variable
+ *
+ *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
+ *  @param a The variable
+ *
+ *  @return The sine and the cosine of @p a, in that order
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename T, typename P>
+std::array<Uncertain<T, P>, 2> sincos(const Uncertain<T, P>& a);
+
+/** @brief Convert Cartesian coordinates to polar coordinates
+ *
+ *  @tparam T The value type of the variables
+ *  @tparam P The propagation policy of the variables
+ *  @param x The x coordinate
+ *  @param y The y coordinate
+ *
+ *  @return The radius and the angle (in radians) of the point (@p x, @p y),
+ *          in that order
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename T, typename P>
+std::array<Uncertain<T, P>, 2> to_polar(const Uncertain<T, P>& x,
+                                        const Uncertain<T, P>& y);
+
+/** @brief Convert polar coordinates to Cartesian coordinates
+ *
+ *  @tparam T The value type of the variables
+ *  @tparam P The propagation policy of the variables
+ *  @param r The radius
+ *  @param theta The angle, in radians
+ *
+ *  @return The x and y coordinates of the point, in that order
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename T, typename P>
+std::array<Uncertain<T, P>, 2> to_cartesian(const Uncertain<T, P>& r,
+                                            const Uncertain<T, P>& theta);
+
+/** @brief Normalize a three-dimensional vector
+ *
+ *  @tparam T The value type of the variables
+ *  @tparam P The propagation policy of the variables
+ *  @param x The x component of the vector
+ *  @param y The y component of the vector
+ *  @param z The z component of the vector
+ *
+ *  @return The components of the unit vector in the direction of
+ *          (@p x, @p y, @p z)
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename T, typename P>
+std::array<Uncertain<T, P>, 3> normalize(const Uncertain<T, P>& x,
+                                         const Uncertain<T, P>& y,
+                                         const Uncertain<T, P>& z);
+
+/** @brief Decompose a variable into fractional and integral parts
+ *
+ *  As with sigma::trunc, the integral part is treated as certain.
+ *
+ *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
+ *  @param a The variable
+ *
+ *  @return The fractional and the integral parts of @p a, in that order
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename T, typename P>
+std::array<Uncertain<T, P>, 2> modf(const Uncertain<T, P>& a);
+
+/** @brief Decompose a variable into a normalized fraction and a power of two
+ *
+ *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
+ *  @param a The variable
+ *
+ *  @return The fraction, with magnitude in [0.5, 1), and the exponent, such
+ *          that @p a equals the fraction times two to the exponent
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename T, typename P>
+std::pair<Uncertain<T, P>, int> frexp(const Uncertain<T, P>& a);
+
+} // namespace sigma
+
+#include "multi_output.ipp"
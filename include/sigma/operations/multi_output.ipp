@@ -0,0 +1,91 @@
+#pragma once
+
+#include "sigma/detail_/math_kernels.hpp"
+#include "sigma/detail_/operation_common.hpp"
+#include <cmath>
+
+namespace sigma {
+
+template<typename T, typename P>
+std::array<Uncertain<T, P>, 2> sincos(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("sincos", a);
+    auto [s, c] = detail_::kernels::sin(a.mean());
+    return detail_::multi_result<T, P, 2, 1>({&a}, {s, c}, {{{c}, {-s}}});
+}
+
+template<typename T, typename P>
+std::array<Uncertain<T, P>, 2> to_polar(const Uncertain<T, P>& x,
+                                        const Uncertain<T, P>& y) {
+    SIGMA_TRACE_OP("to_polar", x, y);
+    if constexpr(!P::propagates) {
+        return {Uncertain<T, P>(std::hypot(x.mean(), y.mean())),
+                Uncertain<T, P>(std::atan2(y.mean(), x.mean()))};
+    } else {
+        auto [r, drdx, drdy] = detail_::kernels::hypot(x.mean(), y.mean());
+        auto [theta, dtdy, dtdx] =
+          detail_::kernels::atan2(y.mean(), x.mean());
+        return detail_::multi_result<T, P, 2, 2>(
+          {&x, &y}, {r, theta}, {{{drdx, drdy}, {dtdx, dtdy}}});
+    }
+}
+
+template<typename T, typename P>
+std::array<Uncertain<T, P>, 2> to_cartesian(const Uncertain<T, P>& r,
+                                            const Uncertain<T, P>& theta) {
+    SIGMA_TRACE_OP("to_cartesian", r, theta);
+    auto [s, c] = detail_::kernels::sin(theta.mean());
+    T x         = r.mean() * c;
+    T y         = r.mean() * s;
+    return detail_::multi_result<T, P, 2, 2>({&r, &theta}, {x, y},
+                                             {{{c, -y}, {s, x}}});
+}
+
+template<typename T, typename P>
+std::array<Uncertain<T, P>, 3> normalize(const Uncertain<T, P>& x,
+                                         const Uncertain<T, P>& y,
+                                         const Uncertain<T, P>& z) {
+    SIGMA_TRACE_OP("normalize", x, y, z);
+    std::array<T, 3> v{x.mean(), y.mean(), z.mean()};
+    T inv_norm = 1 / std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+
+    std::array<T, 3> n;
+    for(std::size_t i = 0; i < 3; ++i) n[i] = v[i] * inv_norm;
+    if constexpr(!P::propagates) {
+        return {Uncertain<T, P>(n[0]), Uncertain<T, P>(n[1]),
+                Uncertain<T, P>(n[2])};
+    } else {
+        // d n_i / d v_j = (delta_ij - n_i n_j) / |v|
+        std::array<std::array<T, 3>, 3> partials;
+        for(std::size_t i = 0; i < 3; ++i) {
+            for(std::size_t j = 0; j < 3; ++j) {
+                T delta        = (i == j) ? 1 : 0;
+                partials[i][j] = (delta - n[i] * n[j]) * inv_norm;
+            }
+        }
+        return detail_::multi_result<T, P, 3, 3>({&x, &y, &z}, n, partials);
+    }
+}
+
+template<typename T, typename P>
+std::array<Uncertain<T, P>, 2> modf(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("modf", a);
+    T integral;
+    T fractional = std::modf(a.mean(), &integral);
+    return {detail_::unary_result(a, fractional, T{1.0}),
+            Uncertain<T, P>(integral)};
+}
+
+template<typename T, typename P>
+std::pair<Uncertain<T, P>, int> frexp(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("frexp", a);
+    int exponent;
+    T fraction = std::frexp(a.mean(), &exponent);
+    if constexpr(!P::propagates) {
+        return {Uncertain<T, P>(fraction), exponent};
+    } else {
+        T dcda = std::ldexp(T{1.0}, -exponent);
+        return {detail_::unary_result(a, fraction, dcda), exponent};
+    }
+}
+
+} // namespace sigma
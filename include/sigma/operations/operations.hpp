@@ -5,6 +5,7 @@
 #include "error_and_gamma.hpp"
 #include "exponents.hpp"
 #include "hyperbolic.hpp"
+#include "multi_output.hpp"
 #include "trigonometry.hpp"
 
 /** @file operations.hpp
@@ -10,102 +10,111 @@ namespace sigma {
 /** @brief Convert from radians to degrees
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param a The variable
  *
  *  @return The variable @p a in degrees
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> degrees(const Uncertain<T>& a);
+template<typename T, typename P>
+Uncertain<T, P> degrees(const Uncertain<T, P>& a);
 
 /** @brief Convert from degrees to radians
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param a The variable
  *
  *  @return The variable @p a in radians
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> radians(const Uncertain<T>& a);
+template<typename T, typename P>
+Uncertain<T, P> radians(const Uncertain<T, P>& a);
 
 /** @brief Sine of the variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param a The variable
  *
  *  @return A variable that is the sine value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> sin(const Uncertain<T>& a);
+template<typename T, typename P>
+Uncertain<T, P> sin(const Uncertain<T, P>& a);
 
 /** @brief Cosine of the variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param a The variable
  *
  *  @return A variable that is the cosine value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> cos(const Uncertain<T>& a);
+template<typename T, typename P>
+Uncertain<T, P> cos(const Uncertain<T, P>& a);
 
 /** @brief Tangent of the variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param a The variable
  *
  *  @return A variable that is the tangent value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> tan(const Uncertain<T>& a);
+template<typename T, typename P>
+Uncertain<T, P> tan(const Uncertain<T, P>& a);
 
 /** @brief Arcsine of the variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param a The variable
  *
  *  @return A variable that is the arcsine value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> asin(const Uncertain<T>& a);
+template<typename T, typename P>
+Uncertain<T, P> asin(const Uncertain<T, P>& a);
 
 /** @brief Arccosine of the variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param a The variable
  *
  *  @return A variable that is the arccosine value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> acos(const Uncertain<T>& a);
+template<typename T, typename P>
+Uncertain<T, P> acos(const Uncertain<T, P>& a);
 
 /** @brief Arctangent of the variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param a The variable
  *
  *  @return A variable that is the arctangent value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> atan(const Uncertain<T>& a);
+template<typename T, typename P>
+Uncertain<T, P> atan(const Uncertain<T, P>& a);
 
 /** @brief Two argument arctangent
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @param y The first variable
  *  @param x The first variable
  *
@@ -113,12 +122,13 @@ Uncertain<T> atan(const Uncertain<T>& a);
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> atan2(const Uncertain<T>& y, const Uncertain<T>& x);
+template<typename T, typename P>
+Uncertain<T, P> atan2(const Uncertain<T, P>& y, const Uncertain<T, P>& x);
 
 /** @brief Two argument arctangent
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @tparam U The numeric type of @p x
  *  @param y The first variable
  *  @param x The first variable
@@ -127,12 +137,13 @@ Uncertain<T> atan2(const Uncertain<T>& y, const Uncertain<T>& x);
  *
  *  @throw none No throw guarantee
  */
-template<typename T, typename U>
-Uncertain<T> atan2(const Uncertain<T>& y, const U& x);
+template<typename T, typename P, typename U>
+Uncertain<T, P> atan2(const Uncertain<T, P>& y, const U& x);
 
 /** @brief Two argument arctangent
  *
  *  @tparam T The value type of the variable
+ *  @tparam P The propagation policy of the variable
  *  @tparam U The numeric type of @p y
  *  @param y The first variable
  *  @param x The first variable
@@ -141,8 +152,8 @@ Uncertain<T> atan2(const Uncertain<T>& y, const U& x);
  *
  *  @throw none No throw guarantee
  */
-template<typename T, typename U>
-Uncertain<T> atan2(const U& y, const Uncertain<T>& x);
+template<typename T, typename P, typename U>
+Uncertain<T, P> atan2(const U& y, const Uncertain<T, P>& x);
 
 } // namespace sigma
 
@@ -1,87 +1,125 @@
 #pragma once
+#include "sigma/detail_/math_kernels.hpp"
 #include "sigma/detail_/operation_common.hpp"
 #include <cmath>
 
 namespace sigma {
 
-template<typename T>
-Uncertain<T> degrees(const Uncertain<T>& a) {
+template<typename T, typename P>
+Uncertain<T, P> degrees(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("degrees", a);
     auto to_degrees = 180.0 / detail_::pi;
     T mean          = a.mean() * to_degrees;
     T dcda          = to_degrees;
     return detail_::unary_result(a, mean, dcda);
 }
 
-template<typename T>
-Uncertain<T> radians(const Uncertain<T>& a) {
+template<typename T, typename P>
+Uncertain<T, P> radians(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("radians", a);
     auto to_radians = detail_::pi / 180.0;
     T mean          = a.mean() * to_radians;
     T dcda          = to_radians;
     return detail_::unary_result(a, mean, dcda);
 }
 
-template<typename T>
-Uncertain<T> sin(const Uncertain<T>& a) {
-    T mean = std::sin(a.mean());
-    T dcda = std::cos(a.mean());
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename P>
+Uncertain<T, P> sin(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("sin", a);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(std::sin(a.mean()));
+    } else {
+        auto [mean, dcda] = detail_::kernels::sin(a.mean());
+        return detail_::unary_result(a, mean, dcda);
+    }
 }
 
-template<typename T>
-Uncertain<T> cos(const Uncertain<T>& a) {
-    T mean = std::cos(a.mean());
-    T dcda = -std::sin(a.mean());
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename P>
+Uncertain<T, P> cos(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("cos", a);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(std::cos(a.mean()));
+    } else {
+        auto [mean, dcda] = detail_::kernels::cos(a.mean());
+        return detail_::unary_result(a, mean, dcda);
+    }
 }
 
-template<typename T>
-Uncertain<T> tan(const Uncertain<T>& a) {
-    T mean = std::tan(a.mean());
-    T dcda = std::pow(std::tan(a.mean()), 2.0) + 1;
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename P>
+Uncertain<T, P> tan(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("tan", a);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(std::tan(a.mean()));
+    } else {
+        auto [mean, dcda] = detail_::kernels::tan(a.mean());
+        return detail_::unary_result(a, mean, dcda);
+    }
 }
 
-template<typename T>
-Uncertain<T> asin(const Uncertain<T>& a) {
-    T mean = std::asin(a.mean());
-    T dcda = 1 / std::sqrt(1 - std::pow(a.mean(), 2));
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename P>
+Uncertain<T, P> asin(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("asin", a);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(std::asin(a.mean()));
+    } else {
+        auto [mean, dcda] = detail_::kernels::asin(a.mean());
+        return detail_::unary_result(a, mean, dcda);
+    }
 }
 
-template<typename T>
-Uncertain<T> acos(const Uncertain<T>& a) {
-    T mean = std::acos(a.mean());
-    T dcda = -1 / std::sqrt(1 - std::pow(a.mean(), 2));
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename P>
+Uncertain<T, P> acos(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("acos", a);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(std::acos(a.mean()));
+    } else {
+        auto [mean, dcda] = detail_::kernels::acos(a.mean());
+        return detail_::unary_result(a, mean, dcda);
+    }
 }
 
-template<typename T>
-Uncertain<T> atan(const Uncertain<T>& a) {
-    T mean = std::atan(a.mean());
-    T dcda = 1 / (1 + std::pow(a.mean(), 2));
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename P>
+Uncertain<T, P> atan(const Uncertain<T, P>& a) {
+    SIGMA_TRACE_OP("atan", a);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(std::atan(a.mean()));
+    } else {
+        auto [mean, dcda] = detail_::kernels::atan(a.mean());
+        return detail_::unary_result(a, mean, dcda);
+    }
 }
 
-template<typename T>
-Uncertain<T> atan2(const Uncertain<T>& y, const Uncertain<T>& x) {
-    T mean = std::atan2(y.mean(), x.mean());
-    T dcda = x.mean() / (std::pow(x.mean(), 2) + std::pow(y.mean(), 2));
-    T dcdb = -y.mean() / (std::pow(x.mean(), 2) + std::pow(y.mean(), 2));
-    return detail_::binary_result(y, x, mean, dcda, dcdb);
+template<typename T, typename P>
+Uncertain<T, P> atan2(const Uncertain<T, P>& y, const Uncertain<T, P>& x) {
+    SIGMA_TRACE_OP("atan2", y, x);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(std::atan2(y.mean(), x.mean()));
+    } else {
+        auto [mean, dcda, dcdb] = detail_::kernels::atan2(y.mean(), x.mean());
+        return detail_::binary_result(y, x, mean, dcda, dcdb);
+    }
 }
 
-template<typename T, typename U>
-Uncertain<T> atan2(const Uncertain<T>& y, const U& x) {
-    T mean = std::atan2(y.mean(), x);
-    T dcda = x / (std::pow(x, 2) + std::pow(y.mean(), 2));
-    return detail_::unary_result(y, mean, dcda);
+template<typename T, typename P, typename U>
+Uncertain<T, P> atan2(const Uncertain<T, P>& y, const U& x) {
+    SIGMA_TRACE_OP("atan2", y);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(std::atan2(y.mean(), T(x)));
+    } else {
+        auto [mean, dcda, dcdb] = detail_::kernels::atan2(y.mean(), T(x));
+        return detail_::unary_result(y, mean, dcda);
+    }
 }
 
-template<typename T, typename U>
-Uncertain<T> atan2(const U& y, const Uncertain<T>& x) {
-    T mean = std::atan2(y, x.mean());
-    T dcda = -y / (std::pow(x.mean(), 2) + std::pow(y, 2));
-    return detail_::unary_result(x, mean, dcda);
+template<typename T, typename P, typename U>
+Uncertain<T, P> atan2(const U& y, const Uncertain<T, P>& x) {
+    SIGMA_TRACE_OP("atan2", x);
+    if constexpr(!P::propagates) {
+        return Uncertain<T, P>(std::atan2(T(y), x.mean()));
+    } else {
+        auto [mean, dcdb, dcda] = detail_::kernels::atan2(T(y), x.mean());
+        return detail_::unary_result(x, mean, dcda);
+    }
 }
 
 } // namespace sigma
@@ -0,0 +1,140 @@
+#pragma once
+#include "sigma/detail_/adaptive_map.hpp"
+#include "sigma/detail_/flat_map.hpp"
+#include "sigma/detail_/hash_map.hpp"
+#include <map>
+#include <type_traits>
+
+/** @file policies.hpp
+ *  @brief Policies selecting how Uncertain values store and propagate their
+ *         uncertainty
+ *
+ *  The policy is the second template parameter of Uncertain. Code written
+ *  against `Uncertain<T, P>` runs unchanged with any policy, so the same path
+ *  can use the storage best suited to each part of a program or, e.g. during
+ *  a warm-up solve, compute only the means.
+ *
+ *  A policy provides:
+ *  - `propagates`, whether the dependencies and standard deviations are
+ *    tracked at all;
+ *  - `deps_map_t<K, V>`, the container mapping each dependency to its partial
+ *    derivative. It needs the subset of the std::map interface made up of
+ *    begin()/end(), size(), empty(), find(), count(), at(), operator[],
+ *    emplace(), emplace_hint(), key_compare and equality. It is iterated in
+ *    key order unless detail_::is_ordered is specialized to false for it.
+ *    Containers with faster kernels than the entry by entry ones also
+ *    overload detail_::accumulate_deps, detail_::scale_deps and
+ *    detail_::variance. Containers that do not allocate one node per entry
+ *    overload detail_::deps_bytes and detail_::deps_copy_allocations.
+ */
+
+namespace sigma {
+
+/** @brief Store the dependencies in a std::map
+ *
+ *  The default policy. Each dependency is its own node, so inserting one is
+ *  cheap at any position, but each is also its own allocation.
+ */
+struct MapStorage {
+    /// Whether the dependencies and standard deviations are tracked
+    static constexpr bool propagates = true;
+
+    /// The container of the dependencies
+    template<typename KeyType, typename MappedType>
+    using deps_map_t = std::map<KeyType, MappedType>;
+};
+
+/** @brief Store the dependencies contiguously, sorted by key
+ *
+ *  A value makes one allocation for all of its dependencies, and merges walk
+ *  both sets in order. Usually the faster choice unless values are built by
+ *  many insertions in the middle of large dependency sets.
+ */
+struct FlatStorage {
+    /// Whether the dependencies and standard deviations are tracked
+    static constexpr bool propagates = true;
+
+    /// The container of the dependencies
+    template<typename KeyType, typename MappedType>
+    using deps_map_t = detail_::FlatMap<KeyType, MappedType>;
+};
+
+/** @brief Store the dependencies sparsely or densely, depending on density
+ *
+ *  Values with few dependencies keep a sorted vector, like FlatStorage. Once a
+ *  value depends on most of a range of variables, typically ones made
+ *  together by make_independent, it switches to an array over that range
+ *  with a bitmap of the entries in use, where merges and standard deviation
+ *  updates need no searching. Suited to pipelines whose late aggregates
+ *  depend on nearly all of many inputs.
+ */
+struct AdaptiveStorage {
+    /// Whether the dependencies and standard deviations are tracked
+    static constexpr bool propagates = true;
+
+    /// The container of the dependencies
+    template<typename KeyType, typename MappedType>
+    using deps_map_t = detail_::AdaptiveMap<KeyType, MappedType>;
+};
+
+/** @brief Store the dependencies in a hash table
+ *
+ *  Lookups take constant time, so adding a value with k dependencies to one
+ *  with n costs O(k) rather than O(n). The dependencies are not kept in key
+ *  order. Suited to very wide values, e.g. accumulators over 10^5 inputs,
+ *  that are repeatedly updated with narrow ones.
+ */
+struct HashStorage {
+    /// Whether the dependencies and standard deviations are tracked
+    static constexpr bool propagates = true;
+
+    /// The container of the dependencies
+    template<typename KeyType, typename MappedType>
+    using deps_map_t = detail_::HashMap<KeyType, MappedType>;
+};
+
+/// Propagate the uncertainty of every operation, with the default storage
+using Propagate = MapStorage;
+
+/** @brief Compute the means only
+ *
+ *  A value holds nothing but its mean, and every operation reduces to the
+ *  plain arithmetic on the means: no dependencies are stored and nothing is
+ *  allocated. The standard deviation is always zero.
+ */
+struct NoPropagation {
+    /// Whether the dependencies and standard deviations are tracked
+    static constexpr bool propagates = false;
+
+    /// The type of the (always empty) dependencies
+    template<typename KeyType, typename MappedType>
+    using deps_map_t = std::map<KeyType, MappedType>;
+};
+
+/** @brief Models an uncertain variable.
+ *
+ *  Declared here so that the default policy is given in one place; defined
+ *  in uncertain.hpp.
+ *
+ *  @tparam ValueType The type of the value and standard deviation
+ *  @tparam PolicyType How the uncertainty is stored and propagated
+ */
+template<typename ValueType, typename PolicyType = Propagate>
+class Uncertain;
+
+namespace detail_ {
+
+/// Whether @p T is an Uncertain type
+template<typename T>
+struct is_uncertain : std::false_type {};
+
+/// Specialization for Uncertain types, with any policy
+template<typename T, typename P>
+struct is_uncertain<Uncertain<T, P>> : std::true_type {};
+
+/// Convenience variable for is_uncertain
+template<typename T>
+constexpr bool is_uncertain_v = is_uncertain<std::decay_t<T>>::value;
+
+} // namespace detail_
+} // namespace sigma
@@ -1,6 +1,13 @@
 #pragma once
+#include "dual.hpp"
 #include "eigen_compat.hpp"
+#include "independent.hpp"
+#include "lift.hpp"
+#include "memory.hpp"
 #include "operations/operations.hpp"
+#include "policies.hpp"
+#include "stats.hpp"
+#include "trace.hpp"
 #include "uncertain.hpp"
 
 /** @file sigma.hpp
@@ -0,0 +1,143 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+
+/** @file stats.hpp
+ *  @brief Optional counters of the work done on dependencies
+ *
+ *  When the library is built with SIGMA_ENABLE_STATS defined, the Setter and
+ *  the operation helpers count the work they do on the dependencies of the
+ *  values they update. The counters are kept per thread, so counting needs no
+ *  synchronization, and each thread only sees its own work. Without
+ *  SIGMA_ENABLE_STATS the counting functions are empty and the counters stay
+ *  at zero.
+ */
+
+namespace sigma {
+
+/// Whether the counters are compiled in
+#ifdef SIGMA_ENABLE_STATS
+inline constexpr bool stats_enabled = true;
+#else
+inline constexpr bool stats_enabled = false;
+#endif
+
+/** @brief Counts of the work done on dependencies by one thread
+ *
+ *  All counts are since the thread started or since its last call to
+ *  reset_stats().
+ */
+struct Stats {
+    /// Dependency maps merged into another, or merged into a shared index
+    std::size_t merges = 0;
+
+    /// Dependency entries read or written by merges, scalings and sd updates
+    std::size_t entries_touched = 0;
+
+    /// Dependency entries and standard deviation cells allocated
+    std::size_t allocations = 0;
+
+    /// Recomputations of a standard deviation from the dependencies
+    std::size_t sd_updates = 0;
+
+    /// The largest number of dependencies of an updated value
+    std::size_t peak_deps = 0;
+};
+
+namespace detail_ {
+
+/// The counters of the calling thread
+inline Stats& thread_stats() {
+    thread_local Stats stats;
+    return stats;
+}
+
+/** @brief Count a merge of dependencies
+ *
+ *  @param entries The number of entries visited by the merge
+ *
+ *  @throw none No throw guarantee
+ */
+inline void count_merge([[maybe_unused]] std::size_t entries) {
+#ifdef SIGMA_ENABLE_STATS
+    auto& stats = thread_stats();
+    ++stats.merges;
+    stats.entries_touched += entries;
+#endif
+}
+
+/** @brief Count entries visited outside of a merge
+ *
+ *  @param entries The number of entries visited
+ *
+ *  @throw none No throw guarantee
+ */
+inline void count_entries([[maybe_unused]] std::size_t entries) {
+#ifdef SIGMA_ENABLE_STATS
+    thread_stats().entries_touched += entries;
+#endif
+}
+
+/** @brief Count allocations of dependency storage
+ *
+ *  @param n The number of allocations
+ *
+ *  @throw none No throw guarantee
+ */
+inline void count_allocations([[maybe_unused]] std::size_t n) {
+#ifdef SIGMA_ENABLE_STATS
+    thread_stats().allocations += n;
+#endif
+}
+
+/** @brief Count a recomputation of a standard deviation
+ *
+ *  @param entries The number of dependencies of the value
+ *
+ *  @throw none No throw guarantee
+ */
+inline void count_sd_update([[maybe_unused]] std::size_t entries) {
+#ifdef SIGMA_ENABLE_STATS
+    auto& stats = thread_stats();
+    ++stats.sd_updates;
+    stats.entries_touched += entries;
+#endif
+}
+
+/** @brief Record the size of an updated dependency set
+ *
+ *  @param n The number of dependencies of the value
+ *
+ *  @throw none No throw guarantee
+ */
+inline void count_deps_size([[maybe_unused]] std::size_t n) {
+#ifdef SIGMA_ENABLE_STATS
+    auto& stats     = thread_stats();
+    stats.peak_deps = std::max(stats.peak_deps, n);
+#endif
+}
+
+} // namespace detail_
+
+/** @brief The counters of the calling thread
+ *
+ *  @code
+ *  sigma::reset_stats();
+ *  auto y = model(x);
+ *  sigma::Stats cost = sigma::stats();
+ *  @endcode
+ *
+ *  @return A copy of the counters of the calling thread. All zero unless
+ *          built with SIGMA_ENABLE_STATS.
+ *
+ *  @throw none No throw guarantee
+ */
+inline Stats stats() { return detail_::thread_stats(); }
+
+/** @brief Reset the counters of the calling thread to zero
+ *
+ *  @throw none No throw guarantee
+ */
+inline void reset_stats() { detail_::thread_stats() = Stats{}; }
+
+} // namespace sigma
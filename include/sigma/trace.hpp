@@ -0,0 +1,389 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+/** @file trace.hpp
+ *  @brief Optional tracing of the latency of operations
+ *
+ *  When the library is built with SIGMA_ENABLE_TRACE defined, every public
+ *  operation records when it started and ended and how many dependencies its
+ *  inputs had. Operations called from within another traced operation, or
+ *  from a SIGMA_TRACE scope of the user, are part of its event rather than
+ *  events of their own. Events go to a fixed-size ring buffer owned by the
+ *  calling thread, so recording takes no locks; once a buffer is full the
+ *  oldest events are overwritten. The events of all threads can be written
+ *  in the Chrome trace format and opened in chrome://tracing or Perfetto.
+ *  Without SIGMA_ENABLE_TRACE the hooks expand to nothing.
+ */
+
+/** @def SIGMA_TRACE_CAPACITY
+ *  @brief The number of events kept per thread
+ */
+#ifndef SIGMA_TRACE_CAPACITY
+#define SIGMA_TRACE_CAPACITY 65536
+#endif
+
+namespace sigma {
+
+/// Whether the tracing hooks are compiled in
+#ifdef SIGMA_ENABLE_TRACE
+inline constexpr bool trace_enabled = true;
+#else
+inline constexpr bool trace_enabled = false;
+#endif
+
+namespace detail_ {
+
+/// One traced call of an operation
+struct TraceEvent {
+    /// The name of the operation, a string literal
+    const char* name;
+
+    /// The start of the call, in nanoseconds of the steady clock
+    std::int64_t start;
+
+    /// The end of the call, in nanoseconds of the steady clock
+    std::int64_t end;
+
+    /// The number of dependencies of the inputs
+    std::size_t deps;
+};
+
+/** @brief The most recent events of one thread
+ *
+ *  Only the owning thread writes events, while write_chrome_trace may read
+ *  them from another thread. Each slot is guarded by a sequence number, a
+ *  seqlock: it is odd while the owner writes the slot and 2 (i + 1) once it
+ *  holds event i. A reader keeps an event only if the sequence number shows
+ *  that event both before and after copying it, so events that are being
+ *  written or have been overwritten are skipped rather than torn.
+ */
+class TraceBuffer {
+public:
+    /// The number of events kept
+    static constexpr std::size_t capacity = SIGMA_TRACE_CAPACITY;
+
+    /** @brief Create an empty buffer
+     *
+     *  @param tid The id of the owning thread in the trace
+     *
+     *  @throw std::bad_alloc if the events cannot be allocated. Strong throw
+     *         guarantee.
+     */
+    explicit TraceBuffer(std::uint32_t tid) :
+      m_tid_(tid), m_slots_(capacity) {}
+
+    /// The id of the owning thread in the trace
+    std::uint32_t tid() const { return m_tid_; }
+
+    /** @brief Record an event, overwriting the oldest one if full
+     *
+     *  @param event The event to record
+     *
+     *  @throw none No throw guarantee
+     */
+    void push(const TraceEvent& event) {
+        constexpr auto relaxed = std::memory_order_relaxed;
+        const auto n           = m_count_.load(relaxed);
+        auto& slot             = m_slots_[n % capacity];
+        slot.seq.store(2 * n + 1, relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.name.store(event.name, relaxed);
+        slot.start.store(event.start, relaxed);
+        slot.end.store(event.end, relaxed);
+        slot.deps.store(event.deps, relaxed);
+        slot.seq.store(2 * n + 2, std::memory_order_release);
+        m_count_.store(n + 1, std::memory_order_release);
+    }
+
+    /** @brief Visit the kept events, oldest first
+     *
+     *  Events that the owner overwrites or is writing during the visit are
+     *  skipped.
+     *
+     *  @tparam FunctionType The type of the visitor
+     *  @param f Called with each event
+     *
+     *  @throw Any exception thrown by @p f. Same throw guarantee.
+     */
+    template<typename FunctionType>
+    void for_each(FunctionType&& f) const {
+        constexpr auto relaxed = std::memory_order_relaxed;
+        const auto n           = m_count_.load(std::memory_order_acquire);
+        const auto first       = (n > capacity) ? n - capacity : 0;
+        for(auto i = first; i < n; ++i) {
+            const auto& slot = m_slots_[i % capacity];
+            const auto seq   = 2 * i + 2;
+            if(slot.seq.load(std::memory_order_acquire) != seq) continue;
+            const TraceEvent event{slot.name.load(relaxed),
+                                   slot.start.load(relaxed),
+                                   slot.end.load(relaxed),
+                                   slot.deps.load(relaxed)};
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if(slot.seq.load(relaxed) != seq) continue;
+            f(event);
+        }
+    }
+
+    /// Discard the events
+    void clear() { m_count_.store(0, std::memory_order_release); }
+
+private:
+    /// A slot of the ring, with the fields of a TraceEvent
+    struct Slot {
+        /// 2 (i + 1) when the slot holds event i, odd while being written
+        std::atomic<std::size_t> seq{0};
+
+        /// The name of the operation
+        std::atomic<const char*> name{nullptr};
+
+        /// The start of the call
+        std::atomic<std::int64_t> start{0};
+
+        /// The end of the call
+        std::atomic<std::int64_t> end{0};
+
+        /// The number of dependencies of the inputs
+        std::atomic<std::size_t> deps{0};
+    };
+
+    /// The id of the owning thread in the trace
+    std::uint32_t m_tid_;
+
+    /// The number of events ever written
+    std::atomic<std::size_t> m_count_{0};
+
+    /// The events, used as a ring
+    std::vector<Slot> m_slots_;
+};
+
+/// The buffers of every thread that has recorded an event
+struct TraceRegistry {
+    /// Guards the list of buffers, not their contents
+    std::mutex mutex;
+
+    /// The buffers, kept after their threads exit
+    std::vector<std::shared_ptr<TraceBuffer>> buffers;
+};
+
+/// The process-wide registry of buffers
+inline TraceRegistry& trace_registry() {
+    static TraceRegistry registry;
+    return registry;
+}
+
+/** @brief The buffer of the calling thread
+ *
+ *  Created and registered on the first call from each thread, which is the
+ *  only time a lock is taken.
+ *
+ *  @throw std::bad_alloc if the buffer cannot be allocated. Strong throw
+ *         guarantee.
+ */
+inline TraceBuffer& thread_trace_buffer() {
+    thread_local std::shared_ptr<TraceBuffer> buffer = [] {
+        auto& registry = trace_registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto tid = static_cast<std::uint32_t>(registry.buffers.size());
+        registry.buffers.push_back(std::make_shared<TraceBuffer>(tid));
+        return registry.buffers.back();
+    }();
+    return *buffer;
+}
+
+/// The current time, in nanoseconds of the steady clock
+inline std::int64_t trace_now() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/// The number of TraceScopes open on the calling thread
+inline std::size_t& trace_depth() noexcept {
+    thread_local std::size_t depth = 0;
+    return depth;
+}
+
+/** @brief Records the duration of its lifetime as an event
+ *
+ *  Created by SIGMA_TRACE at the start of an operation; the event is recorded
+ *  when the operation returns or throws. Only the outermost scope of a thread
+ *  records an event, so an operation that forwards to other traced operations
+ *  (e.g. `2.0 * x` to `x * 2.0` and `operator*=`) appears once, and summing
+ *  the events by name counts each call once.
+ */
+class TraceScope {
+public:
+    /** @brief Start timing an operation
+     *
+     *  @param name The name of the operation, a string literal
+     *  @param deps The number of dependencies of the inputs
+     *
+     *  @throw none No throw guarantee
+     */
+    TraceScope(const char* name, std::size_t deps) :
+      m_name_(name),
+      m_deps_(deps),
+      m_outermost_(trace_depth()++ == 0),
+      m_start_(m_outermost_ ? trace_now() : 0) {}
+
+    /// Record the event, if this is the outermost scope
+    ~TraceScope() {
+        --trace_depth();
+        if(!m_outermost_) return;
+        try {
+            auto& buffer = thread_trace_buffer();
+            buffer.push({m_name_, m_start_, trace_now(), m_deps_});
+        } catch(...) {
+            // A thread that cannot allocate its buffer goes untraced
+        }
+    }
+
+    TraceScope(const TraceScope&)            = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    /// The name of the operation
+    const char* m_name_;
+
+    /// The number of dependencies of the inputs
+    std::size_t m_deps_;
+
+    /// Whether no other scope was open on this thread when this one started
+    bool m_outermost_;
+
+    /// The start of the operation
+    std::int64_t m_start_;
+};
+
+/// The number of dependencies of an input that is not uncertain
+template<typename T>
+std::size_t trace_deps_of(const T&, long) {
+    return 0;
+}
+
+/// The number of dependencies of an input with dependencies, preferred
+template<typename T>
+auto trace_deps_of(const T& x, int) -> decltype(x.deps().size()) {
+    return x.deps().size();
+}
+
+/** @brief The total number of dependencies of the inputs of an operation
+ *
+ *  @tparam Args The types of the inputs
+ *  @param args The inputs; those without deps() count as zero
+ *
+ *  @return The sum of the dependency counts of @p args
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename... Args>
+std::size_t trace_deps(const Args&... args) {
+    return (std::size_t{0} + ... + trace_deps_of(args, 0));
+}
+
+} // namespace detail_
+
+/** @def SIGMA_TRACE(name, deps)
+ *  @brief Trace the rest of the enclosing scope as an operation
+ *
+ *  @param name The name of the operation, a string literal
+ *  @param deps The number of dependencies of the inputs
+ */
+
+/** @def SIGMA_TRACE_OP(name, ...)
+ *  @brief Trace the rest of the enclosing scope as an operation on the
+ *         listed inputs
+ *
+ *  @param name The name of the operation, a string literal
+ *  @param ... The inputs, whose dependencies are counted
+ */
+#ifdef SIGMA_ENABLE_TRACE
+#define SIGMA_TRACE(name, deps) \
+    const ::sigma::detail_::TraceScope sigma_trace_scope_(name, deps)
+#else
+#define SIGMA_TRACE(name, deps) static_cast<void>(0)
+#endif
+#define SIGMA_TRACE_OP(name, ...) \
+    SIGMA_TRACE(name, ::sigma::detail_::trace_deps(__VA_ARGS__))
+
+/** @brief Write the traced events of all threads as a Chrome trace
+ *
+ *  Each event is a complete ("X") event with the number of dependencies as
+ *  an argument, and timestamps relative to the earliest event. Other threads
+ *  may keep recording during the write; events they record or overwrite
+ *  meanwhile may be left out, but no event is written half-updated.
+ *
+ *  @code
+ *  std::ofstream file("sigma_trace.json");
+ *  sigma::write_chrome_trace(file);
+ *  @endcode
+ *
+ *  @param os The stream to write to
+ *
+ *  @throws std::bad_alloc if there is insufficient memory for the copy of
+ *          the events. Strong throw guarantee.
+ *  @throws std::ios_base::failure if anything goes wrong while writing.
+ *          Weak throw guarantee.
+ */
+inline void write_chrome_trace(std::ostream& os) {
+    auto& registry = detail_::trace_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    // Copy the events first, so both passes below see the same ones
+    std::vector<std::vector<detail_::TraceEvent>> events;
+    events.reserve(registry.buffers.size());
+    std::int64_t origin = std::numeric_limits<std::int64_t>::max();
+    for(const auto& buffer : registry.buffers) {
+        auto& copy = events.emplace_back();
+        buffer->for_each([&](const detail_::TraceEvent& e) {
+            if(e.start < origin) origin = e.start;
+            copy.push_back(e);
+        });
+    }
+
+    // Microseconds, keeping the nanoseconds as three decimals
+    auto microseconds = [&os](std::int64_t ns) -> std::ostream& {
+        return os << ns / 1000 << '.' << std::setw(3) << std::setfill('0')
+                  << ns % 1000;
+    };
+
+    const auto fill = os.fill();
+    bool first      = true;
+    os << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+    for(std::size_t b = 0; b < events.size(); ++b) {
+        for(const auto& e : events[b]) {
+            os << (first ? "\n" : ",\n") << "{\"name\": \"" << e.name
+               << "\", \"cat\": \"sigma\", \"ph\": \"X\", \"pid\": 0"
+               << ", \"tid\": " << registry.buffers[b]->tid() << ", \"ts\": ";
+            microseconds(e.start - origin) << ", \"dur\": ";
+            microseconds(e.end - e.start)
+              << ", \"args\": {\"deps\": " << e.deps << "}}";
+            first = false;
+        }
+    }
+    os << "\n]}\n";
+    os.fill(fill);
+}
+
+/** @brief Discard the traced events of all threads
+ *
+ *  Should only be called while no other thread is running operations.
+ *
+ *  @throw none No throw guarantee
+ */
+inline void clear_trace() {
+    auto& registry = detail_::trace_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for(const auto& buffer : registry.buffers) buffer->clear();
+}
+
+} // namespace sigma
@@ -1,4 +1,8 @@
 #pragma once
+#include "sigma/detail_/cell_allocator.hpp"
+#include "sigma/detail_/footprint.hpp"
+#include "sigma/policies.hpp"
+#include "sigma/stats.hpp"
 #include <cmath>
 #include <iostream>
 #include <map>
@@ -27,17 +31,22 @@ class Setter; // Class to alter values inside Uncertain
  *  instance.
  *
  *  @tparam ValueType The type of the value and standard deviation
+ *  @tparam PolicyType How the uncertainty is stored and propagated, see
+ *                     policies.hpp. Propagate by default.
  *
  */
-template<typename ValueType>
+template<typename ValueType, typename PolicyType>
 class Uncertain {
 public:
     /// Type of the instance
-    using my_t = Uncertain<ValueType>;
+    using my_t = Uncertain<ValueType, PolicyType>;
 
     /// The numeric type of the variable
     using value_t = ValueType;
 
+    /// How the uncertainty is stored and propagated
+    using policy_t = PolicyType;
+
     /// The type of a standard deviation this depends on
     using dep_sd_t = value_t;
 
@@ -45,7 +54,8 @@ public:
     using dep_sd_ptr = std::shared_ptr<dep_sd_t>;
 
     /// A map of dependencies and their contributions to the uncertainty
-    using deps_map_t = std::map<dep_sd_ptr, value_t>;
+    using deps_map_t =
+      typename policy_t::template deps_map_t<dep_sd_ptr, value_t>;
 
     /// @brief Default ctor
     Uncertain() noexcept = default;
@@ -73,6 +83,49 @@ public:
      */
     Uncertain(value_t mean, value_t sd);
 
+#ifdef SIGMA_ENABLE_STATS
+    /** @brief Copy ctor, counting the allocations of the copied dependencies
+     *
+     *  Only user-provided when the stats are enabled, so that copies of the
+     *  dependency map count as allocations: one per entry of a std::map, one
+     *  per block of the contiguous containers.
+     *
+     *  @param other The variable to copy
+     *
+     *  @throw std::bad_alloc if the dependencies cannot be copied. Strong
+     *         throw guarantee.
+     */
+    Uncertain(const Uncertain& other) :
+      m_mean_(other.m_mean_), m_sd_(other.m_sd_), m_deps_(other.m_deps_) {
+        detail_::count_allocations(detail_::deps_copy_allocations(m_deps_));
+    }
+
+    /** @brief Copy assignment, counting the allocations of the copied
+     *         dependencies
+     *
+     *  @param other The variable to copy
+     *
+     *  @return *this, after the copy
+     *
+     *  @throw std::bad_alloc if the dependencies cannot be copied. Strong
+     *         throw guarantee.
+     */
+    Uncertain& operator=(const Uncertain& other) {
+        if(this == &other) return *this;
+        m_deps_ = other.m_deps_;
+        m_mean_ = other.m_mean_;
+        m_sd_   = other.m_sd_;
+        detail_::count_allocations(detail_::deps_copy_allocations(m_deps_));
+        return *this;
+    }
+
+    /// Move ctor, which allocates nothing
+    Uncertain(Uncertain&&) noexcept = default;
+
+    /// Move assignment, which allocates nothing
+    Uncertain& operator=(Uncertain&&) noexcept = default;
+#endif
+
     /** @brief Get the mean value of the variable
      *
      *  @return The value of the mean
@@ -117,13 +170,108 @@ private:
 
 }; // class Uncertain
 
+/** @brief An Uncertain value that only computes its mean
+ *
+ *  Has the interface of Uncertain, so the operations and user code templated
+ *  on the policy accept it, but holds nothing except the mean. The standard
+ *  deviation is zero and the dependencies are empty.
+ *
+ *  @tparam ValueType The type of the value
+ */
+template<typename ValueType>
+class Uncertain<ValueType, NoPropagation> {
+public:
+    /// Type of the instance
+    using my_t = Uncertain<ValueType, NoPropagation>;
+
+    /// The numeric type of the variable
+    using value_t = ValueType;
+
+    /// How the uncertainty is stored and propagated
+    using policy_t = NoPropagation;
+
+    /// The type of a standard deviation this depends on
+    using dep_sd_t = value_t;
+
+    /// A pointer to a dependency of this variable
+    using dep_sd_ptr = std::shared_ptr<dep_sd_t>;
+
+    /// A map of dependencies and their contributions to the uncertainty
+    using deps_map_t =
+      typename policy_t::template deps_map_t<dep_sd_ptr, value_t>;
+
+    /// @brief Default ctor
+    Uncertain() noexcept = default;
+
+    /** @brief Construct a value from its mean
+     *
+     *  @param mean The value of the variable
+     *
+     *  @throw none No throw guarantee
+     */
+    Uncertain(value_t mean) : m_mean_(mean) {}
+
+    /** @brief Construct a value from mean and standard deviation
+     *
+     *  The standard deviation is discarded, so no independent variable is
+     *  created.
+     *
+     *  @param mean The average value of the variable
+     *  @param sd The standard deviation of the variable, ignored
+     *
+     *  @throw none No throw guarantee
+     */
+    Uncertain(value_t mean, value_t /*sd*/) : m_mean_(mean) {}
+
+    /** @brief Get the mean value of the variable
+     *
+     *  @return The value of the mean
+     *
+     *  @throw none No throw guarantee
+     */
+    value_t mean() const { return m_mean_; }
+
+    /** @brief Get the standard deviation of the variable
+     *
+     *  @return Zero, as uncertainty is not propagated
+     *
+     *  @throw none No throw guarantee
+     */
+    value_t sd() const { return value_t{0.0}; }
+
+    /** @brief Get the dependencies of the variable
+     *
+     *  @return An empty map, shared by all instances
+     *
+     *  @throw none No throw guarantee
+     */
+    const deps_map_t& deps() const {
+        static const deps_map_t no_deps;
+        return no_deps;
+    }
+
+private:
+    /// Mean value of the variable
+    value_t m_mean_;
+
+    /** A friendly class used by functions to manipulate the private members
+     *  of a variable that is being updated
+     */
+    template<typename T>
+    friend class detail_::Setter;
+
+}; // class Uncertain<ValueType, NoPropagation>
+
 // -- Out-of-line Definitions --------------------------------------------------
 
-template<typename ValueType>
-Uncertain<ValueType>::Uncertain(value_t mean, value_t sd) :
+template<typename ValueType, typename PolicyType>
+Uncertain<ValueType, PolicyType>::Uncertain(value_t mean, value_t sd) :
   m_mean_(mean), m_sd_(std::abs(sd)) {
-    m_deps_.emplace(
-      std::make_pair(std::make_shared<dep_sd_t>(sd), value_t{1.0}));
+    auto cell = std::allocate_shared<dep_sd_t>(
+      detail_::CellAllocator<dep_sd_t>{}, sd);
+    m_deps_.emplace(std::make_pair(std::move(cell), value_t{1.0}));
+    // The standard deviation cell and the map node
+    detail_::count_allocations(2);
 }
 
 // -- Utility functions --------------------------------------------------------
@@ -132,6 +280,7 @@ Uncertain<ValueType>::Uncertain(value_t mean, value_t sd) :
  *  @brief Overload stream insertion to print uncertain variable
  *
  *  @tparam ValueType The numerical type of the variable
+ *  @tparam PolicyType How the uncertainty of the variable is propagated
  *  @param os The ostream to write to
  *  @param u The uncertain variable to write
  *
@@ -140,8 +289,9 @@ Uncertain<ValueType>::Uncertain(value_t mean, value_t sd) :
  *  @throws std::ios_base::failure if anything goes wrong while writing.
  *          Weak throw guarantee.
  */
-template<typename ValueType>
-std::ostream& operator<<(std::ostream& os, const Uncertain<ValueType>& u) {
+template<typename ValueType, typename PolicyType>
+std::ostream& operator<<(std::ostream& os,
+                         const Uncertain<ValueType, PolicyType>& u) {
     os << u.mean() << "+/-" << u.sd();
     return os;
 }
@@ -150,15 +300,16 @@ std::ostream& operator<<(std::ostream& os, const Uncertain<ValueType>& u) {
  *  @brief Compare two variables for equality
  *
  *  @tparam ValueType The numerical type of the variable
+ *  @tparam PolicyType How the uncertainty of the variables is propagated
  *  @param lhs The first variable
  *  @param rhs The second variable
  *
  *  @return Whether the instances are equivalent
  *
  */
-template<typename ValueType1, typename ValueType2>
-bool operator==(const Uncertain<ValueType1>& lhs,
-                const Uncertain<ValueType2>& rhs) {
+template<typename ValueType1, typename ValueType2, typename PolicyType>
+bool operator==(const Uncertain<ValueType1, PolicyType>& lhs,
+                const Uncertain<ValueType2, PolicyType>& rhs) {
     if constexpr(!std::is_same_v<ValueType1, ValueType2>) {
         return false;
     } else {
@@ -173,15 +324,16 @@ bool operator==(const Uncertain<ValueType1>& lhs,
  *  @brief Compare two variables for inequality
  *
  *  @tparam ValueType The numerical type of the variable
+ *  @tparam PolicyType How the uncertainty of the variables is propagated
  *  @param lhs The first variable
  *  @param rhs The second variable
  *
  *  @return Whether the instances are not equivalent
  *
  */
-template<typename ValueType1, typename ValueType2>
-bool operator!=(const Uncertain<ValueType1>& lhs,
-                const Uncertain<ValueType2>& rhs) {
+template<typename ValueType1, typename ValueType2, typename PolicyType>
+bool operator!=(const Uncertain<ValueType1, PolicyType>& lhs,
+                const Uncertain<ValueType2, PolicyType>& rhs) {
     return !(lhs == rhs);
 }
 
@@ -191,15 +343,16 @@ bool operator!=(const Uncertain<ValueType1>& lhs,
  *  Compares the mean values of the two variables
  *
  *  @tparam ValueType The numerical type of the variable
+ *  @tparam PolicyType How the uncertainty of the variables is propagated
  *  @param lhs The first variable
  *  @param rhs The second variable
  *
  *  @return Whether @p lhs is less than @p rhs
  *
  */
-template<typename ValueType1, typename ValueType2>
-bool operator<(const Uncertain<ValueType1>& lhs,
-               const Uncertain<ValueType2>& rhs) {
+template<typename ValueType1, typename ValueType2, typename PolicyType>
+bool operator<(const Uncertain<ValueType1, PolicyType>& lhs,
+               const Uncertain<ValueType2, PolicyType>& rhs) {
     return lhs.mean() < rhs.mean();
 }
 
@@ -209,15 +362,16 @@ bool operator<(const Uncertain<ValueType1>& lhs,
  *  Compares the mean values of the two variables
  *
  *  @tparam ValueType The numerical type of the variable
+ *  @tparam PolicyType How the uncertainty of the variables is propagated
  *  @param lhs The first variable
  *  @param rhs The second variable
  *
  *  @return Whether @p lhs is greater than @p rhs
  *
  */
-template<typename ValueType1, typename ValueType2>
-bool operator>(const Uncertain<ValueType1>& lhs,
-               const Uncertain<ValueType2>& rhs) {
+template<typename ValueType1, typename ValueType2, typename PolicyType>
+bool operator>(const Uncertain<ValueType1, PolicyType>& lhs,
+               const Uncertain<ValueType2, PolicyType>& rhs) {
     return rhs < lhs;
 }
 
@@ -225,15 +379,16 @@ bool operator>(const Uncertain<ValueType1>& lhs,
  *  @brief Whether one variable is less than or equal to another
  *
  *  @tparam ValueType The numerical type of the variable
+ *  @tparam PolicyType How the uncertainty of the variables is propagated
  *  @param lhs The first variable
  *  @param rhs The second variable
  *
  *  @return Whether @p lhs is less than or equal to @p rhs
  *
  */
-template<typename ValueType1, typename ValueType2>
-bool operator<=(const Uncertain<ValueType1>& lhs,
-                const Uncertain<ValueType2>& rhs) {
+template<typename ValueType1, typename ValueType2, typename PolicyType>
+bool operator<=(const Uncertain<ValueType1, PolicyType>& lhs,
+                const Uncertain<ValueType2, PolicyType>& rhs) {
     return (lhs == rhs) || (lhs < rhs);
 }
 
@@ -241,15 +396,16 @@ bool operator<=(const Uncertain<ValueType1>& lhs,
  *  @brief Whether one variable is greater than or equal to another
  *
  *  @tparam ValueType The numerical type of the variable
+ *  @tparam PolicyType How the uncertainty of the variables is propagated
  *  @param lhs The first variable
  *  @param rhs The second variable
  *
  *  @return Whether @p lhs is greater than or equal to @p rhs
  *
  */
-template<typename ValueType1, typename ValueType2>
-bool operator>=(const Uncertain<ValueType1>& lhs,
-                const Uncertain<ValueType2>& rhs) {
+template<typename ValueType1, typename ValueType2, typename PolicyType>
+bool operator>=(const Uncertain<ValueType1, PolicyType>& lhs,
+                const Uncertain<ValueType2, PolicyType>& rhs) {
     return (lhs == rhs) || (lhs > rhs);
 }
 
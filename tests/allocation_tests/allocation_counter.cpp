@@ -0,0 +1,59 @@
+#include "allocation_counter.hpp"
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+/// Whether the allocations of this thread are being counted
+thread_local bool counting = false;
+
+/// The number of counted allocations of this thread
+thread_local std::size_t n_allocations = 0;
+
+void* counted_malloc(std::size_t size) {
+    if(counting) ++n_allocations;
+    if(size == 0) size = 1;
+    if(void* p = std::malloc(size)) return p;
+    throw std::bad_alloc();
+}
+
+} // namespace
+
+void* operator new(std::size_t size) { return counted_malloc(size); }
+
+void* operator new[](std::size_t size) { return counted_malloc(size); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return counted_malloc(size);
+    } catch(...) { return nullptr; }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return counted_malloc(size);
+    } catch(...) { return nullptr; }
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete[](void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace testing {
+
+AllocationCounter::AllocationCounter() :
+  m_start_(n_allocations), m_was_counting_(counting) {
+    counting = true;
+}
+
+AllocationCounter::~AllocationCounter() { counting = m_was_counting_; }
+
+std::size_t AllocationCounter::count() const {
+    return n_allocations - m_start_;
+}
+
+} // namespace testing
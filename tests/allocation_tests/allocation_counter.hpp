@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+
+/** @file allocation_counter.hpp
+ *  @brief Counting of the heap allocations made by a piece of code
+ *
+ *  The global operator new and operator delete are replaced in
+ *  allocation_counter.cpp, which is why these tests are a separate
+ *  executable.
+ */
+
+namespace testing {
+
+/** @brief Counts the allocations of the calling thread during its lifetime
+ *
+ *  @code
+ *  AllocationCounter counter;
+ *  auto c = a + b;
+ *  REQUIRE(counter.count() <= 2 * n);
+ *  @endcode
+ */
+class AllocationCounter {
+public:
+    /// Start counting
+    AllocationCounter();
+
+    /// Stop counting
+    ~AllocationCounter();
+
+    AllocationCounter(const AllocationCounter&)            = delete;
+    AllocationCounter& operator=(const AllocationCounter&) = delete;
+
+    /// The number of allocations since construction
+    std::size_t count() const;
+
+private:
+    /// The allocation count of the thread at construction
+    std::size_t m_start_;
+
+    /// Whether counting was already on, for nested counters
+    bool m_was_counting_;
+};
+
+} // namespace testing
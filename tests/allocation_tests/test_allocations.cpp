@@ -0,0 +1,174 @@
+#include "../fixtures.hpp"
+#include "allocation_counter.hpp"
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <memory>
+#include <sigma/sigma.hpp>
+#include <vector>
+
+using testing::AllocationCounter;
+using testing::fan_in_value;
+
+namespace {
+
+/// The fan-ins the operations are checked at
+const std::vector<std::size_t> fan_ins{1, 10, 100, 1000};
+
+/// Two values with disjoint dependencies and one sharing those of the first
+template<typename T>
+struct Inputs {
+    explicit Inputs(std::size_t n) :
+      a(fan_in_value(n, T(0.5))),
+      b(fan_in_value(n, T(0.25))),
+      c(a * T(2.0)) {}
+
+    sigma::Uncertain<T> a, b, c;
+};
+
+/// The number of allocations made by @p f, whose result is then destroyed
+template<typename FunctionType>
+std::size_t allocations(FunctionType&& f) {
+    AllocationCounter counter;
+    [[maybe_unused]] decltype(auto) result = f();
+    return counter.count();
+}
+
+} // namespace
+
+// The bounds allow one allocation per dependency of the result, plus one for
+// a shared index where noted. Storage that allocates less still passes. The
+// fan-ins are looped over inside each section, since Catch2 only enters a
+// section once per run.
+
+TEMPLATE_TEST_CASE("Allocations of arithmetic", "", sigma::UFloat,
+                   sigma::UDouble) {
+    using value_t = typename TestType::value_t;
+
+    SECTION("Unary") {
+        for(auto n : fan_ins) {
+            INFO("fan-in " << n);
+            const Inputs<value_t> in(n);
+            REQUIRE(allocations([&] { return -in.a; }) <= n);
+            REQUIRE(allocations([&] { return in.a + 2.0; }) <= n);
+            REQUIRE(allocations([&] { return in.a * 2.0; }) <= n);
+            REQUIRE(allocations([&] { return 2.0 / in.a; }) <= n);
+        }
+    }
+    SECTION("Binary, disjoint dependencies") {
+        for(auto n : fan_ins) {
+            INFO("fan-in " << n);
+            const Inputs<value_t> in(n);
+            REQUIRE(allocations([&] { return in.a + in.b; }) <= 2 * n);
+            REQUIRE(allocations([&] { return in.a - in.b; }) <= 2 * n);
+            REQUIRE(allocations([&] { return in.a * in.b; }) <= 2 * n);
+            REQUIRE(allocations([&] { return in.a / in.b; }) <= 2 * n);
+        }
+    }
+    SECTION("Binary, shared dependencies") {
+        for(auto n : fan_ins) {
+            INFO("fan-in " << n);
+            const Inputs<value_t> in(n);
+            REQUIRE(allocations([&] { return in.a + in.c; }) <= n);
+            REQUIRE(allocations([&] { return in.a * in.c; }) <= n);
+        }
+    }
+    SECTION("In place") {
+        for(auto n : fan_ins) {
+            INFO("fan-in " << n);
+            const Inputs<value_t> in(n);
+            TestType x(in.a);
+            // Updating existing dependencies allocates nothing
+            REQUIRE(allocations([&]() -> TestType& { return x *= 2.0; }) == 0);
+            REQUIRE(allocations([&]() -> TestType& { return x += in.c; }) == 0);
+            REQUIRE(allocations([&]() -> TestType& { return x += in.b; }) <= n);
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("Allocations of exponents", "", sigma::UFloat,
+                   sigma::UDouble) {
+    using value_t = typename TestType::value_t;
+
+    SECTION("Unary") {
+        for(auto n : fan_ins) {
+            INFO("fan-in " << n);
+            const Inputs<value_t> in(n);
+            REQUIRE(allocations([&] { return sigma::exp(in.a); }) <= n);
+            REQUIRE(allocations([&] { return sigma::log(in.a); }) <= n);
+            REQUIRE(allocations([&] { return sigma::sqrt(in.a); }) <= n);
+            REQUIRE(allocations([&] { return sigma::cbrt(in.a); }) <= n);
+            REQUIRE(allocations([&] { return sigma::pow(in.a, 2.5); }) <= n);
+        }
+    }
+    SECTION("Binary") {
+        for(auto n : fan_ins) {
+            INFO("fan-in " << n);
+            const Inputs<value_t> in(n);
+            REQUIRE(allocations([&] { return sigma::pow(in.a, in.b); }) <=
+                    2 * n);
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("Allocations of trigonometry", "", sigma::UFloat,
+                   sigma::UDouble) {
+    using value_t = typename TestType::value_t;
+
+    SECTION("Unary") {
+        for(auto n : fan_ins) {
+            INFO("fan-in " << n);
+            const Inputs<value_t> in(n);
+            REQUIRE(allocations([&] { return sigma::sin(in.a); }) <= n);
+            REQUIRE(allocations([&] { return sigma::cos(in.a); }) <= n);
+            REQUIRE(allocations([&] { return sigma::tan(in.a); }) <= n);
+            REQUIRE(allocations([&] { return sigma::asin(in.a); }) <= n);
+            REQUIRE(allocations([&] { return sigma::atan(in.a); }) <= n);
+        }
+    }
+    SECTION("Binary") {
+        for(auto n : fan_ins) {
+            INFO("fan-in " << n);
+            const Inputs<value_t> in(n);
+            REQUIRE(allocations([&] { return sigma::atan2(in.a, in.b); }) <=
+                    2 * n);
+            REQUIRE(allocations([&] { return sigma::hypot(in.a, in.b); }) <=
+                    2 * n);
+        }
+    }
+    SECTION("Several outputs") {
+        for(auto n : fan_ins) {
+            INFO("fan-in " << n);
+            const Inputs<value_t> in(n);
+            // Plus the merged index shared by the outputs
+            REQUIRE(allocations([&] { return sigma::sincos(in.a); }) <=
+                    2 * n + 1);
+            REQUIRE(allocations([&] { return sigma::to_polar(in.a, in.b); }) <=
+                    4 * n + 1);
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("Allocations without propagation", "", sigma::UFloat,
+                   sigma::UDouble) {
+    using value_t = typename TestType::value_t;
+    using fast_t  = sigma::Uncertain<value_t, sigma::NoPropagation>;
+
+    const fast_t a(0.5, 0.1), b(0.25, 0.1);
+    REQUIRE(allocations([&] { return a * b + sigma::exp(a); }) == 0);
+    REQUIRE(allocations([&] { return sigma::atan2(a, b); }) == 0);
+    REQUIRE(allocations([&] { return sigma::to_polar(a, b); }) == 0);
+}
+
+TEST_CASE("AllocationCounter") {
+    AllocationCounter counter;
+    REQUIRE(counter.count() == 0);
+    auto p = std::make_unique<int>(1);
+    REQUIRE(counter.count() == 1);
+    {
+        AllocationCounter inner;
+        std::vector<int> v(10);
+        REQUIRE(inner.count() == 1);
+    }
+    REQUIRE(counter.count() == 2);
+}
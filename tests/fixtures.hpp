@@ -0,0 +1,72 @@
+#pragma once
+#include <cstddef>
+#include <sigma/sigma.hpp>
+#include <vector>
+#ifdef ENABLE_EIGEN_SUPPORT
+#include <Eigen/Dense>
+#endif
+
+/** @file fixtures.hpp
+ *  @brief Inputs shared by the unit tests, allocation tests and benchmarks
+ *
+ *  Included by relative path, e.g. `#include "../fixtures.hpp"`, so that it
+ *  needs no include directory of its own.
+ */
+
+namespace testing {
+
+/** @brief A value that depends on a number of independent variables
+ *
+ *  The variables are created in one block, and each contributes equally to
+ *  the mean of the result.
+ *
+ *  @tparam T The value type of the variables
+ *  @param n The number of independent variables
+ *  @param mean The mean of the result
+ *
+ *  @return A value with mean @p mean and @p n dependencies
+ *
+ *  @throw std::bad_alloc if the variables cannot be allocated. Strong throw
+ *         guarantee.
+ */
+template<typename T>
+sigma::Uncertain<T> fan_in_value(std::size_t n, T mean) {
+    std::vector<T> means(n, mean / T(n)), sds(n, T(0.01) / T(n));
+    auto vars = sigma::make_independent(means, sds);
+
+    sigma::Uncertain<T> x(0.0);
+    for(const auto& var : vars) x += var;
+    return x;
+}
+
+#ifdef ENABLE_EIGEN_SUPPORT
+
+/** @brief A matrix of independent variables with varied means
+ *
+ *  The variables are created in one block, with standard deviations of 1% of
+ *  their means.
+ *
+ *  @tparam MatrixType The type of the matrix, of Uncertain values
+ *  @param rows The number of rows
+ *  @param cols The number of columns
+ *
+ *  @return A @p rows by @p cols matrix of independent variables
+ *
+ *  @throw std::bad_alloc if the variables cannot be allocated. Strong throw
+ *         guarantee.
+ */
+template<typename MatrixType>
+MatrixType independent_matrix(Eigen::Index rows, Eigen::Index cols) {
+    using value_t = typename MatrixType::Scalar::value_t;
+    Eigen::Matrix<value_t, Eigen::Dynamic, Eigen::Dynamic> means(rows, cols);
+    for(Eigen::Index j = 0; j < cols; ++j) {
+        for(Eigen::Index i = 0; i < rows; ++i) {
+            means(i, j) = value_t((i * 7 + j * 3) % 11) - value_t(5);
+        }
+    }
+    return sigma::make_independent(means, means * value_t(0.01));
+}
+
+#endif // ENABLE_EIGEN_SUPPORT
+
+} // namespace testing
@@ -0,0 +1,156 @@
+#include "../testing.hpp"
+#include <algorithm>
+#include <memory>
+#include <sigma/detail_/adaptive_map.hpp>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using cell_ptr_t = std::shared_ptr<const double>;
+using map_t      = sigma::detail_::AdaptiveMap<cell_ptr_t, double>;
+
+namespace {
+
+/// Keys to consecutive cells of one block, like make_independent makes
+std::vector<cell_ptr_t> make_keys(std::size_t n) {
+    auto block = std::make_shared<std::vector<double>>(n, 1.0);
+    std::vector<cell_ptr_t> keys;
+    for(std::size_t i = 0; i < n; ++i) keys.emplace_back(block, &(*block)[i]);
+    return keys;
+}
+
+/// A map with derivative @p value for the keys [first, last)
+map_t make_map(const std::vector<cell_ptr_t>& keys, std::size_t first,
+               std::size_t last, double value) {
+    map_t m;
+    for(auto i = first; i < last; ++i) m.emplace_hint(m.end(), keys[i], value);
+    return m;
+}
+
+/// The derivatives of @p m for every key, zero where there is no entry
+std::vector<double> values(const map_t& m,
+                           const std::vector<cell_ptr_t>& keys) {
+    std::vector<double> result;
+    for(const auto& key : keys) {
+        result.push_back(m.count(key) ? m.at(key) : 0.0);
+    }
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("AdaptiveMap") {
+    const auto n = 8 * map_t::dense_min_size;
+    auto keys    = make_keys(n);
+    map_t m;
+    REQUIRE(m.empty());
+
+    SECTION("Lookup") {
+        m.emplace(keys[3], 3.0);
+        m.emplace(keys[1], 1.0);
+        REQUIRE_FALSE(m.emplace(keys[3], 4.0).second);
+        REQUIRE(m.size() == 2);
+        REQUIRE(m.count(keys[1]) == 1);
+        REQUIRE(m.count(keys[2]) == 0);
+        REQUIRE(m.find(keys[2]) == m.end());
+        REQUIRE(m.find(keys[3])->second == 3.0);
+        REQUIRE(m.at(keys[1]) == 1.0);
+        REQUIRE_THROWS_AS(m.at(keys[2]), std::out_of_range);
+        m[keys[2]] += 2.0;
+        REQUIRE(values(m, {keys[1], keys[2], keys[3]}) ==
+                std::vector<double>{1.0, 2.0, 3.0});
+    }
+    SECTION("Becomes dense once most of the window is used") {
+        m = make_map(keys, 0, map_t::dense_min_size - 1, 1.0);
+        REQUIRE_FALSE(m.is_dense());
+        m[keys[map_t::dense_min_size - 1]] = 1.0;
+        REQUIRE(m.is_dense());
+        REQUIRE(m.size() == map_t::dense_min_size);
+
+        // Growing the window keeps the entries
+        m[keys[n - 1]] = 2.0;
+        REQUIRE_FALSE(m.is_dense());
+        REQUIRE(m.size() == map_t::dense_min_size + 1);
+        REQUIRE(m.at(keys[0]) == 1.0);
+        REQUIRE(m.at(keys[n - 1]) == 2.0);
+    }
+    SECTION("Keys from separately allocated blocks") {
+        // A large block is mapped far away from the first one
+        auto far = make_keys(100000);
+        m        = make_map(keys, 0, map_t::dense_min_size, 1.0);
+        REQUIRE(m.is_dense());
+
+        REQUIRE(m.emplace(far[0], 2.0).second);
+        REQUIRE_FALSE(m.is_dense());
+        m[far[1]] = 3.0;
+        REQUIRE(m.size() == map_t::dense_min_size + 2);
+        REQUIRE(m.at(keys[0]) == 1.0);
+        REQUIRE(m.at(far[0]) == 2.0);
+        REQUIRE(m.at(far[1]) == 3.0);
+    }
+    SECTION("Iterates in key order in either layout") {
+        for(auto dense : {false, true}) {
+            const std::size_t step = dense ? 1 : 5;
+            map_t sparse;
+            for(std::size_t i = 0; i < n; i += step) sparse[keys[i]] = 1.0;
+            REQUIRE(sparse.is_dense() == dense);
+            std::size_t count = 0;
+            for(auto it = sparse.begin(); it != sparse.end(); ++it, ++count) {
+                REQUIRE(it->first == keys[count * step]);
+            }
+            REQUIRE(count == sparse.size());
+        }
+    }
+    SECTION("Accumulate") {
+        auto dense_a  = make_map(keys, 0, n / 2, 1.0);
+        auto dense_b  = make_map(keys, n / 4, n, 1.0);
+        auto sparse_a = make_map(keys, n / 2, n / 2 + 8, 1.0);
+        auto sparse_b = make_map(keys, n / 2 + 4, n / 2 + 12, 1.0);
+        REQUIRE(dense_a.is_dense());
+        REQUIRE(dense_b.is_dense());
+        REQUIRE_FALSE(sparse_a.is_dense());
+
+        auto check = [&](map_t to, const map_t& from) {
+            auto expected     = values(to, keys);
+            auto added        = values(from, keys);
+            std::size_t n_new = 0;
+            for(std::size_t i = 0; i < n; ++i) {
+                if(!to.count(keys[i]) && from.count(keys[i])) ++n_new;
+                expected[i] += 2.0 * added[i];
+            }
+            REQUIRE(to.accumulate(from, 2.0) == n_new);
+            REQUIRE(values(to, keys) == expected);
+            auto in_use = [&to](const cell_ptr_t& k) { return to.count(k); };
+            auto size   = std::count_if(keys.begin(), keys.end(), in_use);
+            REQUIRE(to.size() == static_cast<std::size_t>(size));
+        };
+
+        SECTION("Sparse into sparse") { check(sparse_a, sparse_b); }
+        SECTION("Sparse into dense") { check(dense_a, sparse_a); }
+        SECTION("Dense into sparse") { check(sparse_b, dense_a); }
+        SECTION("Dense into dense") { check(dense_a, dense_b); }
+        SECTION("Into an empty map") { check(m, dense_b); }
+        SECTION("With itself") {
+            auto expected = values(dense_a, keys);
+            for(auto& x : expected) x *= 3.0;
+            REQUIRE(dense_a.accumulate(dense_a, 2.0) == 0);
+            REQUIRE(values(dense_a, keys) == expected);
+        }
+    }
+    SECTION("Scale and sum of squares") {
+        for(auto last : {std::size_t{8}, n}) {
+            auto x = make_map(keys, 0, last, 1.0);
+            x.scale(3.0);
+            REQUIRE(x.at(keys[0]) == 3.0);
+            REQUIRE(x.sum_of_squares() == Catch::Approx(9.0 * last));
+        }
+    }
+    SECTION("Comparison") {
+        auto dense = make_map(keys, 0, n, 1.0);
+        auto other = make_map(keys, 0, n, 1.0);
+        REQUIRE(dense == other);
+        other[keys[0]] = 2.0;
+        REQUIRE(dense != other);
+        REQUIRE(m != dense);
+    }
+}
@@ -0,0 +1,123 @@
+#include "../testing.hpp"
+#include <algorithm>
+#include <map>
+#include <sigma/detail_/flat_map.hpp>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using map_t = sigma::detail_::FlatMap<int, double>;
+
+namespace {
+
+std::vector<std::pair<int, double>> entries(const map_t& m) {
+    return {m.begin(), m.end()};
+}
+
+} // namespace
+
+TEST_CASE("gallop") {
+    const std::vector<int> v{1, 3, 3, 5, 7, 9, 11, 13, 15, 17};
+    auto less = [](int a, int b) { return a < b; };
+    for(int key = 0; key <= 18; ++key) {
+        const auto expected = std::lower_bound(v.begin(), v.end(), key);
+        REQUIRE(sigma::detail_::gallop(v.begin(), v.end(), key, less) ==
+                expected);
+        REQUIRE(sigma::detail_::gallop_back(v.begin(), v.end(), key, less) ==
+                expected);
+    }
+    REQUIRE(sigma::detail_::gallop(v.end(), v.end(), 1, less) == v.end());
+    REQUIRE(sigma::detail_::gallop_back(v.begin(), v.begin(), 1, less) ==
+            v.begin());
+}
+
+TEST_CASE("FlatMap") {
+    map_t m;
+    REQUIRE(m.empty());
+
+    SECTION("Insertion keeps the keys sorted") {
+        REQUIRE(m.emplace(3, 3.0).second);
+        REQUIRE(m.emplace(1, 1.0).second);
+        REQUIRE_FALSE(m.emplace(3, 4.0).second);
+        m.emplace_hint(m.end(), 5, 5.0);
+        m.emplace_hint(m.end(), 2, 2.0); // Wrong hint
+        m[4] += 4.0;
+        using entries_t = std::vector<std::pair<int, double>>;
+        REQUIRE(entries(m) ==
+                entries_t{{1, 1.0}, {2, 2.0}, {3, 3.0}, {4, 4.0}, {5, 5.0}});
+    }
+    SECTION("Lookup") {
+        m.emplace(1, 1.0);
+        m.emplace(3, 3.0);
+        REQUIRE(m.count(1) == 1);
+        REQUIRE(m.count(2) == 0);
+        REQUIRE(m.find(2) == m.end());
+        REQUIRE(m.find(3)->second == 3.0);
+        REQUIRE(m.at(1) == 1.0);
+        REQUIRE_THROWS_AS(m.at(2), std::out_of_range);
+    }
+    SECTION("Accumulate") {
+        m.emplace(1, 1.0);
+        m.emplace(3, 3.0);
+        map_t other;
+        using entries_t = std::vector<std::pair<int, double>>;
+
+        SECTION("Existing keys only") {
+            other.emplace(3, 1.0);
+            REQUIRE(m.accumulate(other, 2.0) == 0);
+            REQUIRE(entries(m) == entries_t{{1, 1.0}, {3, 5.0}});
+        }
+        SECTION("New and existing keys") {
+            other.emplace(0, 1.0);
+            other.emplace(2, 1.0);
+            other.emplace(3, 1.0);
+            other.emplace(4, 1.0);
+            REQUIRE(m.accumulate(other, 2.0) == 3);
+            REQUIRE(entries(m) == entries_t{{0, 2.0},
+                                            {1, 1.0},
+                                            {2, 2.0},
+                                            {3, 5.0},
+                                            {4, 2.0}});
+        }
+        SECTION("Into an empty map") {
+            REQUIRE(other.accumulate(m, -1.0) == 2);
+            REQUIRE(entries(other) == entries_t{{1, -1.0}, {3, -3.0}});
+        }
+        SECTION("With itself") {
+            REQUIRE(m.accumulate(m, 1.0) == 0);
+            REQUIRE(entries(m) == entries_t{{1, 2.0}, {3, 6.0}});
+        }
+    }
+    SECTION("Accumulate unbalanced sizes") {
+        // Every third key in the large map, every 37th in the small one
+        std::map<int, double> large, small;
+        for(int k = 0; k < 3000; k += 3) large[k] = 1.0;
+        for(int k = -1; k < 3010; k += 37) small[k] = 2.0;
+        using entries_t = std::vector<std::pair<int, double>>;
+
+        auto to_map = [](const std::map<int, double>& ref) {
+            map_t result;
+            for(const auto& entry : ref) result.emplace(entry);
+            return result;
+        };
+        auto check = [&](std::map<int, double> to,
+                         const std::map<int, double>& from) {
+            auto testing     = to_map(to);
+            const auto n_old = to.size();
+            for(const auto& [k, v] : from) to[k] += 0.5 * v;
+            const auto n_new = to.size() - n_old;
+            REQUIRE(testing.accumulate(to_map(from), 0.5) == n_new);
+            REQUIRE(entries(testing) == entries_t(to.begin(), to.end()));
+        };
+
+        SECTION("Small into large") { check(large, small); }
+        SECTION("Large into small") { check(small, large); }
+    }
+    SECTION("Comparison") {
+        map_t other;
+        m.emplace(1, 1.0);
+        REQUIRE(m != other);
+        other[1] = 1.0;
+        REQUIRE(m == other);
+    }
+}
@@ -0,0 +1,112 @@
+#include "../testing.hpp"
+#include <memory>
+#include <sigma/detail_/hash_map.hpp>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using cell_ptr_t = std::shared_ptr<const double>;
+using map_t      = sigma::detail_::HashMap<cell_ptr_t, double>;
+
+namespace {
+
+/// Keys to consecutive cells of one block, like make_independent makes
+std::vector<cell_ptr_t> make_keys(std::size_t n) {
+    auto block = std::make_shared<std::vector<double>>(n, 1.0);
+    std::vector<cell_ptr_t> keys;
+    for(std::size_t i = 0; i < n; ++i) keys.emplace_back(block, &(*block)[i]);
+    return keys;
+}
+
+/// A map with derivative @p value for the keys [first, last)
+map_t make_map(const std::vector<cell_ptr_t>& keys, std::size_t first,
+               std::size_t last, double value) {
+    map_t m;
+    for(auto i = first; i < last; ++i) m.emplace(keys[i], value);
+    return m;
+}
+
+/// The derivatives of @p m for every key, zero where there is no entry
+std::vector<double> values(const map_t& m,
+                           const std::vector<cell_ptr_t>& keys) {
+    std::vector<double> result;
+    for(const auto& key : keys) {
+        result.push_back(m.count(key) ? m.at(key) : 0.0);
+    }
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("HashMap") {
+    const auto n = 8 * map_t::index_min_size;
+    auto keys    = make_keys(n + 1);
+    map_t m;
+    REQUIRE(m.empty());
+
+    SECTION("Lookup") {
+        for(auto last : {std::size_t{4}, n}) {
+            m = make_map(keys, 0, last, 1.0);
+            REQUIRE(m.is_indexed() == (last >= map_t::index_min_size));
+            REQUIRE_FALSE(m.emplace(keys[3], 4.0).second);
+            REQUIRE(m.size() == last);
+            REQUIRE(m.count(keys[1]) == 1);
+            REQUIRE(m.count(keys[last]) == 0);
+            REQUIRE(m.find(keys[last]) == m.end());
+            REQUIRE(m.find(keys[3])->second == 1.0);
+            REQUIRE_THROWS_AS(m.at(keys[last]), std::out_of_range);
+            m[keys[last]] += 2.0;
+            REQUIRE(m.at(keys[last]) == 2.0);
+        }
+    }
+    SECTION("Keeps the insertion order") {
+        for(auto i = n; i-- > 0;) m.emplace_hint(m.end(), keys[i], 1.0);
+        std::size_t i = n;
+        for(const auto& [key, value] : m) REQUIRE(key == keys[--i]);
+    }
+    SECTION("Reserve indexes the existing entries") {
+        m = make_map(keys, 0, 4, 1.0);
+        m.reserve(n);
+        REQUIRE(m.is_indexed());
+        REQUIRE(m.count(keys[2]) == 1);
+        m = make_map(keys, 4, n, 1.0);
+        REQUIRE(m.count(keys[n - 1]) == 1);
+    }
+    SECTION("Accumulate") {
+        auto wide   = make_map(keys, 0, n - 8, 1.0);
+        auto narrow = make_map(keys, n - 12, n, 1.0);
+
+        auto check = [&](map_t to, const map_t& from) {
+            auto expected     = values(to, keys);
+            auto added        = values(from, keys);
+            std::size_t n_new = 0;
+            for(std::size_t i = 0; i < n; ++i) {
+                if(!to.count(keys[i]) && from.count(keys[i])) ++n_new;
+                expected[i] += 2.0 * added[i];
+            }
+            const auto n_old = to.size();
+            REQUIRE(to.accumulate(from, 2.0) == n_new);
+            REQUIRE(to.size() == n_old + n_new);
+            REQUIRE(values(to, keys) == expected);
+        };
+
+        SECTION("Narrow into wide") { check(wide, narrow); }
+        SECTION("Wide into narrow") { check(narrow, wide); }
+        SECTION("Into an empty map") { check(m, wide); }
+        SECTION("With itself") {
+            auto expected = values(wide, keys);
+            for(auto& x : expected) x *= 3.0;
+            REQUIRE(wide.accumulate(wide, 2.0) == 0);
+            REQUIRE(values(wide, keys) == expected);
+        }
+    }
+    SECTION("Comparison ignores the order") {
+        auto forward = make_map(keys, 0, n, 1.0);
+        map_t backward;
+        for(auto i = n; i-- > 0;) backward.emplace(keys[i], 1.0);
+        REQUIRE(forward == backward);
+        backward[keys[0]] = 2.0;
+        REQUIRE(forward != backward);
+        REQUIRE(m != forward);
+    }
+}
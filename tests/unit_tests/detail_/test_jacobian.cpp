@@ -0,0 +1,54 @@
+#ifdef ENABLE_EIGEN_SUPPORT
+
+#include "testing.hpp"
+#include <sigma/detail_/jacobian.hpp>
+#include <sigma/sigma.hpp>
+
+TEMPLATE_TEST_CASE("DependencyIndex", "", sigma::UFloat, sigma::UDouble) {
+    using testing_t = TestType;
+    using value_t   = typename testing_t::value_t;
+    using umatrix_t = Eigen::Matrix<testing_t, Eigen::Dynamic, Eigen::Dynamic>;
+
+    testing_t a{1.0, 0.1}, b{2.0, 0.2}, c{3.0, 0.3};
+    umatrix_t m(2, 2);
+    m << a, a * b, testing_t(4.0), c;
+
+    sigma::detail_::DependencyIndex<value_t> index;
+    index.add(m);
+    index.add(b);
+    index.finalize();
+
+    SECTION("Size") { REQUIRE(index.size() == 3); }
+    SECTION("Columns follow the key order") {
+        for(std::size_t col = 0; col < index.size(); ++col) {
+            REQUIRE(index.column(index.variable(col)) == col);
+        }
+        for(std::size_t col = 1; col < index.size(); ++col) {
+            REQUIRE(index.variable(col - 1) < index.variable(col));
+        }
+    }
+    SECTION("gather_jacobian") {
+        auto jac = sigma::detail_::gather_jacobian(m, index);
+        REQUIRE(jac.rows() == 4);
+        REQUIRE(jac.cols() == 3);
+        REQUIRE(jac.nonZeros() == 4);
+        auto col_a = index.column(a.deps().begin()->first);
+        auto col_b = index.column(b.deps().begin()->first);
+        auto col_c = index.column(c.deps().begin()->first);
+        // Rows are the column-major positions of the elements
+        REQUIRE(jac.coeff(0, col_a) == Catch::Approx(1.0));
+        REQUIRE(jac.coeff(2, col_a) == Catch::Approx(2.0));
+        REQUIRE(jac.coeff(2, col_b) == Catch::Approx(1.0));
+        REQUIRE(jac.coeff(1, col_c) == Catch::Approx(0.0));
+        REQUIRE(jac.coeff(3, col_c) == Catch::Approx(1.0));
+    }
+    SECTION("mean_matrix") {
+        auto means = sigma::detail_::mean_matrix(m);
+        REQUIRE(means(0, 0) == Catch::Approx(1.0));
+        REQUIRE(means(0, 1) == Catch::Approx(2.0));
+        REQUIRE(means(1, 0) == Catch::Approx(4.0));
+        REQUIRE(means(1, 1) == Catch::Approx(3.0));
+    }
+}
+
+#endif // ENABLE_EIGEN_SUPPORT
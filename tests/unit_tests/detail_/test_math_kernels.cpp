@@ -0,0 +1,103 @@
+#include "../testing.hpp"
+#include <cmath>
+#include <limits>
+#include <sigma/detail_/math_kernels.hpp>
+#include <vector>
+
+namespace {
+
+template<typename T, typename KernelType, typename FunctionType,
+         typename DerivativeType>
+void check_kernel(KernelType kernel, FunctionType f, DerivativeType df, T x) {
+    auto [value, deriv] = kernel(x);
+    REQUIRE(value == Catch::Approx(f(x)));
+    REQUIRE(deriv == Catch::Approx(df(x)));
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE("Math Kernels", "", float, double) {
+    namespace kernels = sigma::detail_::kernels;
+    using testing_t   = TestType;
+
+    testing_t x = 0.4;
+
+    SECTION("Trigonometric") {
+        check_kernel<testing_t>(
+          [](auto v) { return kernels::sin(v); },
+          [](auto v) { return std::sin(v); },
+          [](auto v) { return std::cos(v); }, x);
+        check_kernel<testing_t>(
+          [](auto v) { return kernels::cos(v); },
+          [](auto v) { return std::cos(v); },
+          [](auto v) { return -std::sin(v); }, x);
+        check_kernel<testing_t>(
+          [](auto v) { return kernels::tan(v); },
+          [](auto v) { return std::tan(v); },
+          [](auto v) { return 1 / std::pow(std::cos(v), 2); }, x);
+        auto [mean, dy, dx] = kernels::atan2(testing_t(1.0), testing_t(2.0));
+        REQUIRE(mean == Catch::Approx(0.4636476));
+        REQUIRE(dy == Catch::Approx(0.4));
+        REQUIRE(dx == Catch::Approx(-0.2));
+    }
+    SECTION("Hyperbolic") {
+        for(testing_t v : {testing_t(-30.0), testing_t(-0.4), testing_t(0.0),
+                           testing_t(1.0e-6), x, testing_t(20.0)}) {
+            check_kernel<testing_t>(
+              [](auto u) { return kernels::sinh(u); },
+              [](auto u) { return std::sinh(u); },
+              [](auto u) { return std::cosh(u); }, v);
+            check_kernel<testing_t>(
+              [](auto u) { return kernels::cosh(u); },
+              [](auto u) { return std::cosh(u); },
+              [](auto u) { return std::sinh(u); }, v);
+        }
+        // Past the overflow of exp, but not yet of sinh and cosh
+        const auto near_max =
+          std::log(std::numeric_limits<testing_t>::max()) + testing_t(0.3);
+        for(testing_t v : {near_max, -near_max}) {
+            auto [sh, ch] = kernels::sinh(v);
+            REQUIRE(std::isfinite(sh));
+            REQUIRE(sh == Catch::Approx(std::sinh(v)));
+            REQUIRE(ch == Catch::Approx(std::cosh(v)));
+        }
+        auto [big_sinh, big_cosh] = kernels::sinh(testing_t(1.0e4));
+        REQUIRE(std::isinf(big_sinh));
+        REQUIRE(std::isinf(big_cosh));
+    }
+    SECTION("Exponents") {
+        check_kernel<testing_t>(
+          [](auto v) { return kernels::exp(v); },
+          [](auto v) { return std::exp(v); },
+          [](auto v) { return std::exp(v); }, x);
+        check_kernel<testing_t>(
+          [](auto v) { return kernels::expm1(v); },
+          [](auto v) { return std::expm1(v); },
+          [](auto v) { return std::exp(v); }, x);
+        check_kernel<testing_t>(
+          [](auto v) { return kernels::cbrt(v); },
+          [](auto v) { return std::cbrt(v); },
+          [](auto v) { return 1 / (3 * std::cbrt(v * v)); }, x);
+        check_kernel<testing_t>(
+          [](auto v) { return kernels::pow(v, 3); },
+          [](auto v) { return v * v * v; },
+          [](auto v) { return 3 * v * v; }, x);
+        auto [zero, dzero] = kernels::pow(testing_t(0.0), 1.0);
+        REQUIRE(zero == 0.0);
+        REQUIRE(dzero == 1.0);
+        auto [p, dpda, dpdb] = kernels::pow_binary(testing_t(2.0), x);
+        REQUIRE(p == Catch::Approx(std::pow(2.0, 0.4)));
+        REQUIRE(dpda == Catch::Approx(0.4 * std::pow(2.0, -0.6)));
+        REQUIRE(dpdb == Catch::Approx(std::log(2.0) * std::pow(2.0, 0.4)));
+    }
+    SECTION("Batched") {
+        std::vector<testing_t> in{-1.0, 0.0, 0.5, 2.0};
+        std::vector<testing_t> values(in.size()), derivs(in.size());
+        kernels::apply([](auto v) { return kernels::sin(v); }, in.data(),
+                       values.data(), derivs.data(), in.size());
+        for(std::size_t i = 0; i < in.size(); ++i) {
+            REQUIRE(values[i] == Catch::Approx(std::sin(in[i])));
+            REQUIRE(derivs[i] == Catch::Approx(std::cos(in[i])));
+        }
+    }
+}
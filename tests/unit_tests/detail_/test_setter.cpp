@@ -4,7 +4,16 @@
 
 using testing::test_uncertain;
 
-TEMPLATE_TEST_CASE("Setter", "", sigma::UFloat, sigma::UDouble) {
+using flat_float_t      = sigma::Uncertain<float, sigma::FlatStorage>;
+using flat_double_t     = sigma::Uncertain<double, sigma::FlatStorage>;
+using adaptive_float_t  = sigma::Uncertain<float, sigma::AdaptiveStorage>;
+using adaptive_double_t = sigma::Uncertain<double, sigma::AdaptiveStorage>;
+using hash_float_t      = sigma::Uncertain<float, sigma::HashStorage>;
+using hash_double_t     = sigma::Uncertain<double, sigma::HashStorage>;
+
+TEMPLATE_TEST_CASE("Setter", "", sigma::UFloat, sigma::UDouble, flat_float_t,
+                   flat_double_t, adaptive_float_t, adaptive_double_t,
+                   hash_float_t, hash_double_t) {
     using uncertain_t = TestType;
     using testing_t   = sigma::detail_::Setter<uncertain_t>;
 
@@ -49,6 +58,14 @@ TEMPLATE_TEST_CASE("Setter", "", sigma::UFloat, sigma::UDouble) {
             }
         }
     }
+    SECTION("Add a dependency") {
+        auto dep = b.deps().begin()->first;
+        testing_a.add_dependency(dep, 2.0);
+        test_uncertain(a, 3.0, 0.3, 2);
+        REQUIRE(a.deps().at(dep) == 2.0);
+        testing_a.update_sd();
+        test_uncertain(a, 3.0, 0.8544, 2);
+    }
     SECTION("Update the standard deviation") {
         // Change derivatives without updating the standard deviation
         testing_a.update_derivatives(0.0, false);
@@ -0,0 +1,32 @@
+#include "../testing.hpp"
+#include <cmath>
+#include <sigma/detail_/special_functions.hpp>
+#include <vector>
+
+TEMPLATE_TEST_CASE("Special Functions", "", float, double) {
+    using testing_t = TestType;
+
+    SECTION("Digamma") {
+        using sigma::detail_::digamma;
+        REQUIRE(digamma(testing_t(1.0)) == Catch::Approx(-0.5772156649));
+        REQUIRE(digamma(testing_t(0.5)) == Catch::Approx(-1.9635100260));
+        REQUIRE(digamma(testing_t(2.5)) == Catch::Approx(0.7031566406));
+        REQUIRE(digamma(testing_t(10.0)) == Catch::Approx(2.2517525891));
+        REQUIRE(digamma(testing_t(1000.0)) == Catch::Approx(6.9072551956));
+        REQUIRE(digamma(testing_t(-0.5)) == Catch::Approx(0.0364899740));
+        REQUIRE(digamma(testing_t(-2.5)) == Catch::Approx(1.1031566406));
+        REQUIRE(std::isnan(digamma(testing_t(0.0))));
+        REQUIRE(std::isnan(digamma(testing_t(-3.0))));
+    }
+    SECTION("Batched Digamma") {
+        using sigma::detail_::digamma;
+        std::vector<testing_t> x{0.1, 0.5, 1.0, 2.5, 7.9, 10.0, 150.0, -0.5,
+                                 -2.5, 0.0};
+        std::vector<testing_t> out(x.size());
+        digamma(x.data(), out.data(), x.size());
+        for(std::size_t i = 0; i + 1 < x.size(); ++i) {
+            REQUIRE(out[i] == Catch::Approx(digamma(x[i])));
+        }
+        REQUIRE(std::isnan(out.back()));
+    }
+}
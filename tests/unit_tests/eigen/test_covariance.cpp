@@ -0,0 +1,69 @@
+#ifdef ENABLE_EIGEN_SUPPORT
+
+#include "testing.hpp"
+#include <Eigen/Dense>
+#include <sigma/sigma.hpp>
+
+TEMPLATE_TEST_CASE("covariance_matrix", "", sigma::UFloat, sigma::UDouble) {
+    using testing_t = TestType;
+    using value_t   = typename testing_t::value_t;
+    using matrix_t  = Eigen::Matrix<value_t, Eigen::Dynamic, Eigen::Dynamic>;
+    using uvector_t = Eigen::Matrix<testing_t, Eigen::Dynamic, 1>;
+
+    testing_t x{1.0, 0.1}, y{2.0, 0.2}, z{3.0, 0.3};
+
+    SECTION("Vector") {
+        uvector_t r(4);
+        r << x + y, x - y, value_t(2) * x, z;
+        matrix_t cov = sigma::covariance_matrix(r);
+        matrix_t corr(4, 4);
+        corr << 0.05, -0.03, 0.02, 0.0, -0.03, 0.05, 0.02, 0.0, 0.02, 0.02,
+          0.04, 0.0, 0.0, 0.0, 0.0, 0.09;
+        REQUIRE(cov.rows() == 4);
+        REQUIRE(cov.cols() == 4);
+        for(Eigen::Index i = 0; i < 4; ++i) {
+            for(Eigen::Index j = 0; j < 4; ++j) {
+                REQUIRE(cov(i, j) == Catch::Approx(corr(i, j)).margin(1e-6));
+            }
+            value_t sd = r(i).sd();
+            REQUIRE(cov(i, i) == Catch::Approx(sd * sd));
+        }
+    }
+    SECTION("Matrix, in column-major order") {
+        Eigen::Matrix<testing_t, Eigen::Dynamic, Eigen::Dynamic> m(2, 2);
+        m << x, y, x * y, testing_t(5.0);
+        matrix_t cov = sigma::covariance_matrix(m);
+        REQUIRE(cov.rows() == 4);
+        // Elements are x, x * y, y, 5
+        REQUIRE(cov(0, 1) == Catch::Approx(0.02));
+        REQUIRE(cov(1, 2) == Catch::Approx(0.04));
+        REQUIRE(cov(0, 2) == Catch::Approx(0.0).margin(1e-6));
+        REQUIRE(cov.row(3).isZero());
+        REQUIRE(cov.isApprox(cov.transpose()));
+    }
+    SECTION("Large, correlated") {
+        // Enough shared dependencies to be split across threads with OpenMP
+        const Eigen::Index n = 300;
+        testing_t offset{0.0, 0.05};
+        uvector_t v(n);
+        for(Eigen::Index i = 0; i < n; ++i) {
+            v(i) = testing_t(value_t(i), value_t(0.01) * value_t(1 + i % 7));
+        }
+        uvector_t r(n);
+        r(0) = v(0) + offset;
+        for(Eigen::Index i = 1; i < n; ++i) r(i) = v(i) + v(i - 1) + offset;
+        matrix_t cov = sigma::covariance_matrix(r);
+        for(Eigen::Index i = 0; i < n; ++i) {
+            value_t sd = r(i).sd();
+            REQUIRE(cov(i, i) == Catch::Approx(sd * sd));
+            if(i > 0) {
+                value_t s = v(i - 1).sd();
+                REQUIRE(cov(i, i - 1) == Catch::Approx(s * s + 0.0025));
+                REQUIRE(cov(i - 1, i) == Catch::Approx(s * s + 0.0025));
+            }
+            if(i > 1) REQUIRE(cov(i, i - 2) == Catch::Approx(0.0025));
+        }
+    }
+}
+
+#endif // ENABLE_EIGEN_SUPPORT
@@ -0,0 +1,81 @@
+#ifdef ENABLE_EIGEN_SUPPORT
+
+#include "testing.hpp"
+#include <Eigen/Dense>
+#include <cmath>
+#include <sigma/sigma.hpp>
+#include <stdexcept>
+
+using testing::test_uncertain;
+
+TEMPLATE_TEST_CASE("eigh", "", sigma::UFloat, sigma::UDouble) {
+    using testing_t = TestType;
+    using value_t   = typename testing_t::value_t;
+    using umatrix_t = Eigen::Matrix<testing_t, Eigen::Dynamic, Eigen::Dynamic>;
+
+    auto u = [](value_t mean) -> testing_t {
+        return testing_t{mean, mean * (value_t)0.1};
+    };
+
+    SECTION("2 x 2") {
+        umatrix_t A(2, 2);
+        A(0, 0) = u(1);
+        A(0, 1) = u(2);
+        A(1, 0) = A(0, 1);
+        A(1, 1) = u(3);
+        auto [evalues, evectors] = sigma::eigh(A);
+        // Same as Eigen::SelfAdjointEigenSolver<umatrix_t>
+        test_uncertain(evalues(0), -0.2361, 0.2100, 3);
+        test_uncertain(evalues(1), 4.2361, 0.2826, 3);
+        test_uncertain(evectors(0, 0), -0.8507, 0.0197, 3);
+        test_uncertain(evectors(0, 1), -0.5257, 0.0318, 3);
+        test_uncertain(evectors(1, 0), 0.5257, 0.0318, 3);
+        test_uncertain(evectors(1, 1), -0.8507, 0.0197, 3);
+    }
+    SECTION("Only the lower triangle is read") {
+        umatrix_t A(2, 2);
+        A(0, 0) = u(1);
+        A(0, 1) = u(100);
+        A(1, 0) = u(2);
+        A(1, 1) = u(3);
+        auto [evalues, evectors] = sigma::eigh(A);
+        test_uncertain(evalues(0), -0.2361, 0.2100, 3);
+        test_uncertain(evalues(1), 4.2361, 0.2826, 3);
+    }
+    SECTION("Agrees with the generic solver") {
+        umatrix_t A(3, 3);
+        A(0, 0) = u(4);
+        A(1, 0) = u(1);
+        A(2, 0) = u(-2);
+        A(1, 1) = u(3);
+        A(2, 1) = A(0, 0) * u(0.5);
+        A(2, 2) = u(-1);
+        A.template triangularView<Eigen::StrictlyUpper>() = A.transpose();
+
+        auto [evalues, evectors] = sigma::eigh(A);
+        Eigen::SelfAdjointEigenSolver<umatrix_t> solver(A);
+        umatrix_t corr_values  = solver.eigenvalues();
+        umatrix_t corr_vectors = solver.eigenvectors();
+        for(Eigen::Index k = 0; k < 3; ++k) {
+            REQUIRE(evalues(k).mean() ==
+                    Catch::Approx(corr_values(k, 0).mean()));
+            REQUIRE(evalues(k).sd() ==
+                    Catch::Approx(corr_values(k, 0).sd()).epsilon(1e-3));
+            REQUIRE(evalues(k).deps().size() == 6);
+            for(Eigen::Index p = 0; p < 3; ++p) {
+                // Eigenvectors are only defined up to their sign
+                using std::abs;
+                REQUIRE(abs(evectors(p, k).mean()) ==
+                        Catch::Approx(abs(corr_vectors(p, k).mean())));
+                REQUIRE(evectors(p, k).sd() ==
+                        Catch::Approx(corr_vectors(p, k).sd()).epsilon(1e-3));
+            }
+        }
+    }
+    SECTION("Not square") {
+        umatrix_t A(2, 3);
+        REQUIRE_THROWS_AS(sigma::eigh(A), std::invalid_argument);
+    }
+}
+
+#endif // ENABLE_EIGEN_SUPPORT
@@ -0,0 +1,62 @@
+#ifdef ENABLE_EIGEN_SUPPORT
+
+#include "testing.hpp"
+#include <Eigen/Dense>
+#include <sigma/sigma.hpp>
+#include <stdexcept>
+
+using testing::test_uncertain;
+
+TEMPLATE_TEST_CASE("Determinant and inverse", "", sigma::UFloat,
+                   sigma::UDouble) {
+    using testing_t = TestType;
+    using value_t   = typename testing_t::value_t;
+    using umatrix_t = Eigen::Matrix<testing_t, Eigen::Dynamic, Eigen::Dynamic>;
+
+    auto u = [](value_t mean) -> testing_t {
+        return testing_t{mean, mean * (value_t)0.1};
+    };
+
+    umatrix_t A(2, 2);
+    A << u(1), u(2), u(3), u(4);
+
+    umatrix_t B(3, 3);
+    B << u(1), u(2), u(3), u(4), u(5), u(6), u(7), u(8), u(10);
+    B(2, 0) = B(0, 0) * B(1, 1);
+
+    SECTION("det") {
+        test_uncertain(sigma::det(A), -2.0, 1.0198, 4);
+
+        auto corr = B.partialPivLu().determinant();
+        auto d    = sigma::det(B);
+        REQUIRE(d.mean() == Catch::Approx(corr.mean()));
+        REQUIRE(d.sd() == Catch::Approx(corr.sd()));
+        REQUIRE(d.deps().size() == 8);
+    }
+    SECTION("logdet") {
+        test_uncertain(sigma::logdet(A), 0.6931, 0.5099, 4);
+
+        umatrix_t C(2, 2);
+        C << u(2), u(-1), u(-1), u(3);
+        test_uncertain(sigma::logdet(C), 1.6094, 0.1720, 4);
+    }
+    SECTION("inverse") {
+        umatrix_t x    = sigma::inverse(B);
+        umatrix_t corr = B.partialPivLu().inverse();
+        for(Eigen::Index i = 0; i < 3; ++i) {
+            for(Eigen::Index j = 0; j < 3; ++j) {
+                REQUIRE(x(i, j).mean() == Catch::Approx(corr(i, j).mean()));
+                REQUIRE(x(i, j).sd() == Catch::Approx(corr(i, j).sd()));
+                REQUIRE(x(i, j).deps().size() == 8);
+            }
+        }
+    }
+    SECTION("Not square") {
+        umatrix_t C(2, 3);
+        REQUIRE_THROWS_AS(sigma::det(C), std::invalid_argument);
+        REQUIRE_THROWS_AS(sigma::logdet(C), std::invalid_argument);
+        REQUIRE_THROWS_AS(sigma::inverse(C), std::invalid_argument);
+    }
+}
+
+#endif // ENABLE_EIGEN_SUPPORT
@@ -0,0 +1,99 @@
+#ifdef ENABLE_EIGEN_SUPPORT
+
+#include "testing.hpp"
+#include <Eigen/Dense>
+#include <sigma/sigma.hpp>
+#include <stdexcept>
+
+TEMPLATE_TEST_CASE("jacobian", "", sigma::UFloat, sigma::UDouble) {
+    using testing_t = TestType;
+    using value_t   = typename testing_t::value_t;
+    using uvector_t = Eigen::Matrix<testing_t, Eigen::Dynamic, 1>;
+
+    testing_t x{1.0, 0.1}, y{2.0, 0.2}, z{3.0, 0.3};
+    uvector_t inputs(3);
+    inputs << x, y, z;
+    uvector_t r(4);
+    r << x * y, value_t(3) * z, testing_t(1.0), y - z;
+
+    SECTION("Columns in order of the inputs") {
+        auto jac = sigma::jacobian(r, inputs);
+        REQUIRE(jac.matrix.rows() == 4);
+        REQUIRE(jac.matrix.cols() == 3);
+        REQUIRE(jac.matrix.nonZeros() == 5);
+        REQUIRE(jac.variables.size() == 3);
+        REQUIRE(*jac.variables[0] == Catch::Approx(0.1));
+        REQUIRE(*jac.variables[1] == Catch::Approx(0.2));
+        REQUIRE(*jac.variables[2] == Catch::Approx(0.3));
+        REQUIRE(jac.matrix.coeff(0, 0) == Catch::Approx(2.0));
+        REQUIRE(jac.matrix.coeff(0, 1) == Catch::Approx(1.0));
+        REQUIRE(jac.matrix.coeff(1, 2) == Catch::Approx(3.0));
+        REQUIRE(jac.matrix.coeff(3, 1) == Catch::Approx(1.0));
+        REQUIRE(jac.matrix.coeff(3, 2) == Catch::Approx(-1.0));
+    }
+    SECTION("Raw CSR arrays") {
+        auto jac          = sigma::jacobian(r, inputs);
+        const int* outer  = jac.matrix.outerIndexPtr();
+        const int* inner  = jac.matrix.innerIndexPtr();
+        const int corr[5] = {0, 1, 2, 1, 2};
+        REQUIRE(outer[0] == 0);
+        REQUIRE(outer[1] == 2);
+        REQUIRE(outer[2] == 3);
+        REQUIRE(outer[3] == 3);
+        REQUIRE(outer[4] == 5);
+        for(int k = 0; k < 5; ++k) REQUIRE(inner[k] == corr[k]);
+    }
+    SECTION("Columns in order of first appearance") {
+        uvector_t s(2);
+        s << z, x + y;
+        auto jac = sigma::jacobian(s);
+        REQUIRE(jac.matrix.cols() == 3);
+        REQUIRE(jac.variables[0] == z.deps().begin()->first);
+        REQUIRE(jac.matrix.coeff(0, 0) == Catch::Approx(1.0));
+        REQUIRE(jac.matrix.row(1).nonZeros() == 2);
+        // The standard deviations are recovered from the Jacobian
+        value_t var = 0;
+        for(int c = 1; c < 3; ++c) {
+            value_t d = jac.matrix.coeff(1, c) * *jac.variables[c];
+            var += d * d;
+        }
+        REQUIRE(std::sqrt(var) == Catch::Approx(s(1).sd()));
+    }
+    SECTION("Large") {
+        // Enough entries to be split across threads with OpenMP
+        const Eigen::Index n = 200;
+        uvector_t v(n), w(n);
+        for(Eigen::Index i = 0; i < n; ++i) {
+            v(i) = testing_t(value_t(i), value_t(1));
+        }
+        for(Eigen::Index i = 0; i < n; ++i) {
+            w(i) = v.head(i + 1).sum() * value_t(2);
+        }
+        auto jac = sigma::jacobian(w, v);
+        REQUIRE(jac.matrix.nonZeros() == n * (n + 1) / 2);
+        for(Eigen::Index i = 0; i < n; ++i) {
+            REQUIRE(jac.matrix.row(i).nonZeros() == i + 1);
+            REQUIRE(jac.matrix.coeff(i, i) == Catch::Approx(2.0));
+            REQUIRE(jac.matrix.row(i).sum() == Catch::Approx(2.0 * (i + 1)));
+        }
+    }
+    SECTION("Invalid inputs") {
+        uvector_t bad(2);
+        bad << x, x;
+        REQUIRE_THROWS_AS(sigma::jacobian(r, bad), std::invalid_argument);
+        bad << x, x * y;
+        REQUIRE_THROWS_AS(sigma::jacobian(r, bad), std::invalid_argument);
+        bad << x, y;
+        REQUIRE_THROWS_AS(sigma::jacobian(r, bad), std::invalid_argument);
+        // Scaled variables depend on one variable, but are not inputs
+        uvector_t scaled(3);
+        scaled << x, y, z;
+        REQUIRE_NOTHROW(sigma::jacobian(r, scaled));
+        scaled << x, y * value_t(2), z;
+        REQUIRE_THROWS_AS(sigma::jacobian(r, scaled), std::invalid_argument);
+        scaled << -x, y, z;
+        REQUIRE_THROWS_AS(sigma::jacobian(r, scaled), std::invalid_argument);
+    }
+}
+
+#endif // ENABLE_EIGEN_SUPPORT
@@ -0,0 +1,204 @@
+#ifdef ENABLE_EIGEN_SUPPORT
+
+#include "../../fixtures.hpp"
+#include "testing.hpp"
+#include <Eigen/Dense>
+#include <algorithm>
+#include <sigma/sigma.hpp>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using testing::independent_matrix;
+
+namespace {
+
+// Reference product built from the scalar operations
+template<typename MatrixType>
+MatrixType elementwise_product(const MatrixType& a, const MatrixType& b) {
+    MatrixType c(a.rows(), b.cols());
+    for(Eigen::Index i = 0; i < a.rows(); ++i) {
+        for(Eigen::Index j = 0; j < b.cols(); ++j) {
+            c(i, j) = a(i, 0) * b(0, j);
+            for(Eigen::Index k = 1; k < a.cols(); ++k) {
+                c(i, j) += a(i, k) * b(k, j);
+            }
+        }
+    }
+    return c;
+}
+
+template<typename MatrixType>
+void compare(const MatrixType& c, const MatrixType& corr) {
+    REQUIRE(c.rows() == corr.rows());
+    REQUIRE(c.cols() == corr.cols());
+    for(Eigen::Index i = 0; i < c.rows(); ++i) {
+        for(Eigen::Index j = 0; j < c.cols(); ++j) {
+            REQUIRE(c(i, j).mean() == Catch::Approx(corr(i, j).mean()));
+            REQUIRE(c(i, j).sd() == Catch::Approx(corr(i, j).sd()));
+            REQUIRE(c(i, j).deps().size() == corr(i, j).deps().size());
+        }
+    }
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE("Split matrix product", "", sigma::UFloat, sigma::UDouble) {
+    using testing_t = TestType;
+    using value_t   = typename testing_t::value_t;
+    using umatrix_t = Eigen::Matrix<testing_t, Eigen::Dynamic, Eigen::Dynamic>;
+
+    // Independent elements, plus some that share variables
+    umatrix_t a(4, 3), b(3, 5);
+    for(Eigen::Index i = 0; i < a.rows(); ++i) {
+        for(Eigen::Index j = 0; j < a.cols(); ++j) {
+            value_t mean = value_t(1 + i) - value_t(0.5) * value_t(j);
+            a(i, j)      = testing_t(mean, value_t(0.1) * value_t(1 + j));
+        }
+    }
+    for(Eigen::Index i = 0; i < b.rows(); ++i) {
+        for(Eigen::Index j = 0; j < b.cols(); ++j) {
+            value_t mean = value_t(2) - value_t(i) + value_t(0.25) * value_t(j);
+            b(i, j)      = testing_t(mean, value_t(0.05) * value_t(1 + i));
+        }
+    }
+    a(1, 1) = a(0, 0) * a(2, 2);
+    b(2, 4) = a(3, 1) + b(0, 0);
+    b(1, 2) = testing_t(1.5);
+
+    SECTION("Matrix times matrix") {
+        umatrix_t c = a * b;
+        compare(c, elementwise_product(a, b));
+    }
+    SECTION("Matrix times vector") {
+        Eigen::Matrix<testing_t, Eigen::Dynamic, 1> x = b.col(4);
+        Eigen::Matrix<testing_t, Eigen::Dynamic, 1> y = a * x;
+        compare(umatrix_t(y), elementwise_product(a, umatrix_t(x)));
+    }
+    SECTION("Accumulation") {
+        umatrix_t c = umatrix_t::Constant(4, 5, testing_t(1.0));
+        c.noalias() += a * b;
+        umatrix_t corr = elementwise_product(a, b);
+        for(Eigen::Index i = 0; i < corr.rows(); ++i) {
+            for(Eigen::Index j = 0; j < corr.cols(); ++j) corr(i, j) += 1.0;
+        }
+        compare(c, corr);
+    }
+    SECTION("Correlated operands") {
+        umatrix_t c = a * a.transpose().eval();
+        compare(c, elementwise_product(a, umatrix_t(a.transpose())));
+    }
+    SECTION("Certain operands") {
+        umatrix_t x = umatrix_t::Identity(3, 3);
+        umatrix_t c = x * x;
+        for(Eigen::Index i = 0; i < 3; ++i) {
+            for(Eigen::Index j = 0; j < 3; ++j) {
+                testing::test_uncertain(c(i, j), i == j ? 1.0 : 0.0, 0.0, 0);
+            }
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("Mixed certain and Uncertain matrices", "", sigma::UFloat,
+                   sigma::UDouble) {
+    using testing_t = TestType;
+    using value_t   = typename testing_t::value_t;
+    using umatrix_t = Eigen::Matrix<testing_t, Eigen::Dynamic, Eigen::Dynamic>;
+    using matrix_t  = Eigen::Matrix<value_t, Eigen::Dynamic, Eigen::Dynamic>;
+
+    umatrix_t a = independent_matrix<umatrix_t>(3, 4);
+    a(2, 3)     = a(0, 0) * a(1, 2);
+    matrix_t d(4, 2), e(2, 3);
+    d << 1, 2, 0, -1, 3, 0, 0.5, 1;
+    e << 2, 0, 1, -1, 4, 0;
+    umatrix_t ud = d.template cast<testing_t>();
+    umatrix_t ue = e.template cast<testing_t>();
+
+    SECTION("Uncertain times certain") {
+        umatrix_t c = a * d;
+        compare(c, elementwise_product(a, ud));
+    }
+    SECTION("Certain times Uncertain") {
+        umatrix_t c = e * a;
+        compare(c, elementwise_product(ue, a));
+    }
+    SECTION("Certain matrix times Uncertain vector") {
+        Eigen::Matrix<testing_t, Eigen::Dynamic, 1> x = a.col(3);
+        Eigen::Matrix<testing_t, Eigen::Dynamic, 1> y = e * x;
+        compare(umatrix_t(y), elementwise_product(ue, umatrix_t(x)));
+    }
+    SECTION("Fixed-size matrices") {
+        Eigen::Matrix<value_t, 2, 2> f;
+        f << 1, 2, 3, 4;
+        Eigen::Matrix<testing_t, 2, 2> g = a.template topLeftCorner<2, 2>();
+        Eigen::Matrix<testing_t, 2, 2> c = f * g;
+        testing::test_uncertain(c(0, 0), value_t(1) * g(0, 0).mean() +
+                                           value_t(2) * g(1, 0).mean(),
+                                (g(0, 0) + value_t(2) * g(1, 0)).sd(), 2);
+    }
+    SECTION("Coefficient-wise operations") {
+        matrix_t m = d.transpose();
+        umatrix_t s = a.topRows(2) + m;
+        umatrix_t p = a.topRows(2).cwiseProduct(m);
+        for(Eigen::Index i = 0; i < 2; ++i) {
+            for(Eigen::Index j = 0; j < 4; ++j) {
+                testing::test_uncertain(s(i, j), a(i, j).mean() + m(i, j),
+                                        a(i, j).sd(), 1);
+                testing::test_uncertain(p(i, j), a(i, j).mean() * m(i, j),
+                                        a(i, j).sd() * std::abs(m(i, j)), 1);
+            }
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("Split matrix product, threaded size", "", sigma::UFloat,
+                   sigma::UDouble) {
+    using umatrix_t = Eigen::Matrix<TestType, Eigen::Dynamic, Eigen::Dynamic>;
+
+    // Large enough to be split across threads when built with OpenMP
+    umatrix_t a = independent_matrix<umatrix_t>(40, 30);
+    umatrix_t b = independent_matrix<umatrix_t>(30, 37);
+    b(3, 4)     = a(1, 2) * b(3, 4);
+
+    umatrix_t c = a * b;
+    compare(c, elementwise_product(a, b));
+}
+
+TEST_CASE("Split matrix product, threaded matches serial") {
+    using umatrix_t =
+      Eigen::Matrix<sigma::UDouble, Eigen::Dynamic, Eigen::Dynamic>;
+
+    umatrix_t a = independent_matrix<umatrix_t>(40, 30);
+    umatrix_t b = independent_matrix<umatrix_t>(30, 37);
+    a(5, 6)     = a(5, 6) * b(0, 0);
+
+#ifdef _OPENMP
+    const int max_threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+    umatrix_t serial = a * b;
+    omp_set_num_threads(std::max(max_threads, 4));
+    umatrix_t threaded = a * b;
+    omp_set_num_threads(max_threads);
+#else
+    umatrix_t serial   = elementwise_product(a, b);
+    umatrix_t threaded = a * b;
+#endif
+
+    for(Eigen::Index j = 0; j < serial.cols(); ++j) {
+        for(Eigen::Index i = 0; i < serial.rows(); ++i) {
+            const auto& x = threaded(i, j);
+            const auto& y = serial(i, j);
+            REQUIRE(x.mean() == Catch::Approx(y.mean()));
+            REQUIRE(x.sd() == Catch::Approx(y.sd()));
+            REQUIRE(x.deps().size() == y.deps().size());
+            auto it = y.deps().begin();
+            for(const auto& [dep, deriv] : x.deps()) {
+                REQUIRE(dep == it->first);
+                REQUIRE(deriv == Catch::Approx(it->second).margin(1.0e-12));
+                ++it;
+            }
+        }
+    }
+}
+
+#endif // ENABLE_EIGEN_SUPPORT
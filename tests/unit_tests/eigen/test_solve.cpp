@@ -0,0 +1,74 @@
+#ifdef ENABLE_EIGEN_SUPPORT
+
+#include "testing.hpp"
+#include <Eigen/Dense>
+#include <sigma/sigma.hpp>
+#include <stdexcept>
+
+using testing::test_uncertain;
+
+TEMPLATE_TEST_CASE("solve", "", sigma::UFloat, sigma::UDouble) {
+    using testing_t = TestType;
+    using value_t   = typename testing_t::value_t;
+    using umatrix_t = Eigen::Matrix<testing_t, Eigen::Dynamic, Eigen::Dynamic>;
+    using uvector_t = Eigen::Matrix<testing_t, Eigen::Dynamic, 1>;
+
+    auto u = [](value_t mean) -> testing_t {
+        return testing_t{mean, mean * (value_t)0.1};
+    };
+
+    umatrix_t A(3, 3);
+    A << u(1), u(2), u(3), u(4), u(5), u(6), u(7), u(8), u(10);
+
+    SECTION("Matrix right-hand side") {
+        umatrix_t b(3, 1);
+        b << u(3), u(3), u(4);
+        umatrix_t x = sigma::solve(A, b);
+        // Same as A.partialPivLu().solve(b)
+        test_uncertain(x(0, 0), -2.0, 2.5016, 12);
+        test_uncertain(x(1, 0), 1.0, 5.7594, 12);
+        test_uncertain(x(2, 0), 1.0, 3.0627, 12);
+    }
+    SECTION("Vector right-hand side") {
+        uvector_t b(3);
+        b << u(3), u(3), u(4);
+        uvector_t x = sigma::solve(A, b);
+        test_uncertain(x(0), -2.0, 2.5016, 12);
+        test_uncertain(x(1), 1.0, 5.7594, 12);
+        test_uncertain(x(2), 1.0, 3.0627, 12);
+    }
+    SECTION("Several right-hand sides") {
+        umatrix_t B(2, 2);
+        B << u(1), u(2), u(3), u(1);
+        umatrix_t A2(2, 2);
+        A2 << u(2), u(-1), u(-1), u(3);
+        umatrix_t x    = sigma::solve(A2, B);
+        umatrix_t corr = A2.partialPivLu().solve(B);
+        for(Eigen::Index i = 0; i < 2; ++i) {
+            for(Eigen::Index j = 0; j < 2; ++j) {
+                REQUIRE(x(i, j).mean() == Catch::Approx(corr(i, j).mean()));
+                REQUIRE(x(i, j).sd() == Catch::Approx(corr(i, j).sd()));
+                // A and the column of B
+                REQUIRE(x(i, j).deps().size() == 6);
+            }
+        }
+    }
+    SECTION("Certain coefficients") {
+        umatrix_t A2 = umatrix_t::Identity(2, 2) * testing_t(2.0);
+        uvector_t b(2);
+        b << u(1), u(2);
+        uvector_t x = sigma::solve(A2, b);
+        // Every element of x depends on every element of b
+        test_uncertain(x(0), 0.5, 0.05, 2);
+        test_uncertain(x(1), 1.0, 0.1, 2);
+    }
+    SECTION("Invalid dimensions") {
+        umatrix_t b(2, 1);
+        b << u(1), u(2);
+        REQUIRE_THROWS_AS(sigma::solve(A, b), std::invalid_argument);
+        REQUIRE_THROWS_AS(sigma::solve(umatrix_t(A.leftCols(2)), A),
+                          std::invalid_argument);
+    }
+}
+
+#endif // ENABLE_EIGEN_SUPPORT
@@ -0,0 +1,92 @@
+#ifdef ENABLE_EIGEN_SUPPORT
+
+#include "testing.hpp"
+#include <Eigen/Sparse>
+#include <sigma/sigma.hpp>
+#include <stdexcept>
+#include <vector>
+
+using testing::test_uncertain;
+
+TEMPLATE_TEST_CASE("Sparse matrices", "", sigma::UFloat, sigma::UDouble) {
+    using testing_t = TestType;
+    using value_t   = typename testing_t::value_t;
+    using umatrix_t = Eigen::Matrix<testing_t, Eigen::Dynamic, Eigen::Dynamic>;
+    using uvector_t = Eigen::Matrix<testing_t, Eigen::Dynamic, 1>;
+    using usparse_t = Eigen::SparseMatrix<testing_t>;
+
+    auto u = [](value_t mean) -> testing_t {
+        return testing_t{mean, mean * (value_t)0.1};
+    };
+
+    // Symmetric tridiagonal, with both triangles stored
+    testing_t off1 = u(-1), off2 = u(-1);
+    std::vector<Eigen::Triplet<testing_t>> triplets{
+      {0, 0, u(4)}, {1, 1, u(5)}, {2, 2, u(6)},  {0, 1, off1},
+      {1, 0, off1}, {1, 2, off2}, {2, 1, off2}};
+    usparse_t A(3, 3);
+    A.setFromTriplets(triplets.begin(), triplets.end());
+
+    uvector_t b(3);
+    b << u(1), u(2), u(3);
+
+    SECTION("Arithmetic") {
+        uvector_t y = A * b;
+        test_uncertain(y(0), 2.0, 0.6325, 4);
+        test_uncertain(y(1), 6.0, 1.4832, 6);
+        test_uncertain(y(2), 16.0, 2.5612, 4);
+    }
+    SECTION("SparseLDLT") {
+        sigma::SparseLDLT<value_t> solver(A);
+        REQUIRE(solver.info() == Eigen::Success);
+        uvector_t x    = solver.solve(b);
+        uvector_t corr = sigma::solve(umatrix_t(A), b);
+        for(Eigen::Index i = 0; i < 3; ++i) {
+            REQUIRE(x(i).mean() == Catch::Approx(corr(i).mean()));
+            REQUIRE(x(i).sd() == Catch::Approx(corr(i).sd()));
+            REQUIRE(x(i).deps().size() == 8);
+        }
+    }
+    SECTION("ConjugateGradient") {
+        sigma::ConjugateGradient<value_t> solver;
+        solver.solver().setTolerance(value_t(1e-6));
+        solver.compute(A);
+        uvector_t x    = solver.solve(b);
+        uvector_t corr = sigma::solve(umatrix_t(A), b);
+        REQUIRE(solver.info() == Eigen::Success);
+        for(Eigen::Index i = 0; i < 3; ++i) {
+            REQUIRE(x(i).mean() == Catch::Approx(corr(i).mean()));
+            REQUIRE(x(i).sd() == Catch::Approx(corr(i).sd()));
+            REQUIRE(x(i).deps().size() == 8);
+        }
+    }
+    SECTION("Derivatives that do not converge") {
+        // The mean solve is trivial, but the derivatives need 3 iterations
+        uvector_t b0(3);
+        b0 << testing_t{0, 1}, testing_t{0, 1}, testing_t{0, 1};
+        sigma::ConjugateGradient<value_t> solver;
+        solver.solver().setMaxIterations(1);
+        solver.compute(A);
+        solver.solve(b0);
+        REQUIRE(solver.info() == Eigen::NoConvergence);
+    }
+    SECTION("Solving after a failed factorization") {
+        // A zero pivot, which SimplicialLDLT cannot factorize
+        std::vector<Eigen::Triplet<testing_t>> zero_pivot{{0, 1, u(1)},
+                                                          {1, 0, u(1)}};
+        usparse_t S(2, 2);
+        S.setFromTriplets(zero_pivot.begin(), zero_pivot.end());
+        sigma::SparseLDLT<value_t> solver(S);
+        REQUIRE(solver.info() != Eigen::Success);
+        REQUIRE_THROWS_AS(solver.solve(b.head(2)), std::runtime_error);
+        REQUIRE(solver.info() != Eigen::Success);
+    }
+    SECTION("Invalid dimensions") {
+        sigma::SparseLDLT<value_t> solver(A);
+        REQUIRE_THROWS_AS(solver.solve(uvector_t(2)), std::invalid_argument);
+        REQUIRE_THROWS_AS(solver.compute(usparse_t(2, 3)),
+                          std::invalid_argument);
+    }
+}
+
+#endif // ENABLE_EIGEN_SUPPORT
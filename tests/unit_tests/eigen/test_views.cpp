@@ -0,0 +1,79 @@
+#ifdef ENABLE_EIGEN_SUPPORT
+
+#include "testing.hpp"
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include <sigma/sigma.hpp>
+#include <stdexcept>
+
+using testing::test_uncertain;
+
+TEMPLATE_TEST_CASE("Matrix views and construction", "", sigma::UFloat,
+                   sigma::UDouble) {
+    using testing_t = TestType;
+    using value_t   = typename testing_t::value_t;
+    using matrix_t  = Eigen::Matrix<value_t, Eigen::Dynamic, Eigen::Dynamic>;
+    using umatrix_t = Eigen::Matrix<testing_t, Eigen::Dynamic, Eigen::Dynamic>;
+
+    testing_t a{1.0, 0.1}, b{2.0, 0.2};
+    umatrix_t m(2, 2);
+    m << a, b, a * b, a - a;
+
+    SECTION("means") {
+        matrix_t corr(2, 2);
+        corr << 1.0, 2.0, 2.0, 0.0;
+        matrix_t x = sigma::means(m);
+        REQUIRE(x.isApprox(corr));
+        // Usable in floating point expressions
+        matrix_t y = sigma::means(m) * value_t(2) + corr;
+        REQUIRE(y.isApprox(3 * corr));
+    }
+    SECTION("sds") {
+        matrix_t x = sigma::sds(m);
+        REQUIRE(x(0, 0) == Catch::Approx(0.1));
+        REQUIRE(x(0, 1) == Catch::Approx(0.2));
+        REQUIRE(x(1, 0) == Catch::Approx(0.2828).margin(1e-4));
+        REQUIRE(x(1, 1) == Catch::Approx(0.0));
+        auto max_sd = sigma::sds(m).maxCoeff();
+        REQUIRE(max_sd == Catch::Approx(0.2828).margin(1e-4));
+    }
+    SECTION("Sparse") {
+        Eigen::SparseMatrix<testing_t> s(3, 3);
+        s.insert(0, 1) = a;
+        s.insert(2, 2) = b;
+        Eigen::SparseMatrix<value_t> x = sigma::means(s);
+        Eigen::SparseMatrix<value_t> y = sigma::sds(s);
+        REQUIRE(x.nonZeros() == 2);
+        REQUIRE(x.coeff(0, 1) == Catch::Approx(1.0));
+        REQUIRE(x.coeff(2, 2) == Catch::Approx(2.0));
+        REQUIRE(y.coeff(2, 2) == Catch::Approx(0.2));
+    }
+    SECTION("make_independent") {
+        matrix_t means(2, 3), sds(2, 3);
+        means << 1.0, 2.0, 3.0, 4.0, 5.0, 6.0;
+        sds << 0.1, 0.2, 0.3, 0.4, 0.5, 0.6;
+        auto x = sigma::make_independent(means, sds);
+        REQUIRE(x.rows() == 2);
+        REQUIRE(x.cols() == 3);
+        test_uncertain(x(0, 0), 1.0, 0.1, 1);
+        test_uncertain(x(0, 2), 3.0, 0.3, 1);
+        test_uncertain(x(1, 0), 4.0, 0.4, 1);
+        test_uncertain(x(1, 2), 6.0, 0.6, 1);
+        test_uncertain(x(0, 0) + x(1, 0), 5.0, 0.4123, 2);
+        // Round trip through the views
+        REQUIRE(matrix_t(sigma::means(x)).isApprox(means));
+        REQUIRE(matrix_t(sigma::sds(x)).isApprox(sds));
+    }
+    SECTION("make_independent from expressions") {
+        Eigen::Matrix<value_t, 3, 1> means(1.0, 2.0, 3.0);
+        auto x = sigma::make_independent(means, means * value_t(0.1));
+        test_uncertain(x(1), 2.0, 0.2, 1);
+    }
+    SECTION("Mismatched shapes") {
+        matrix_t means(2, 2), sds(2, 3);
+        REQUIRE_THROWS_AS(sigma::make_independent(means, sds),
+                          std::invalid_argument);
+    }
+}
+
+#endif // ENABLE_EIGEN_SUPPORT
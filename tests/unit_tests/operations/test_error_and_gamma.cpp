@@ -8,6 +8,7 @@ TEMPLATE_TEST_CASE("Error Function and Gamma", "", sigma::UFloat,
     using testing_t = TestType;
 
     auto a = testing_t(1.0, 0.1);
+    auto b = testing_t(2.5, 0.1);
     SECTION("Error Function") {
         test_uncertain(sigma::erf(a), 0.8427, 0.0415, 1);
     }
@@ -17,8 +18,10 @@ TEMPLATE_TEST_CASE("Error Function and Gamma", "", sigma::UFloat,
     }
     SECTION("Gamma Function") {
         test_uncertain(sigma::tgamma(a), 1.0, 0.0577, 1);
+        test_uncertain(sigma::tgamma(b), 1.3293, 0.0935, 1);
     }
     SECTION("Gamma Function Natural Logarithm") {
         test_uncertain(sigma::lgamma(a), 0.0, 0.0577, 1);
+        test_uncertain(sigma::lgamma(b), 0.2847, 0.0703, 1);
     }
 }
\ No newline at end of file
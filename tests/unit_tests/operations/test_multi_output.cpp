@@ -0,0 +1,61 @@
+#include "../testing.hpp"
+#include <sigma/sigma.hpp>
+
+using testing::test_uncertain;
+
+TEMPLATE_TEST_CASE("Multiple Outputs", "", sigma::UFloat, sigma::UDouble) {
+    using testing_t = TestType;
+
+    auto a = testing_t(0.785398, 0.1);
+    auto x = testing_t(1.0, 0.1);
+    auto y = testing_t(2.0, 0.2);
+    auto z = testing_t(2.0, 0.3);
+
+    SECTION("Sine and Cosine") {
+        auto [s, c] = sigma::sincos(a);
+        test_uncertain(s, 0.7071, 0.0707, 1);
+        test_uncertain(c, 0.7071, 0.0707, 1);
+        REQUIRE(s == sigma::sin(a));
+        test_uncertain(s * s + c * c, 1.0, 0.0, 1);
+    }
+    SECTION("Cartesian to Polar") {
+        auto [r, theta] = sigma::to_polar(x, y);
+        test_uncertain(r, 2.2361, 0.1844, 2);
+        test_uncertain(theta, 1.1071, 0.0566, 2);
+        auto r_corr = sigma::hypot(x, y);
+        test_uncertain(r, r_corr.mean(), r_corr.sd(), 2);
+    }
+    SECTION("Polar to Cartesian") {
+        auto [u, v] = sigma::to_cartesian(y, a);
+        test_uncertain(u, 1.4142, 0.2000, 2);
+        test_uncertain(v, 1.4142, 0.2000, 2);
+        auto v_corr = y * sigma::sin(a);
+        test_uncertain(v, v_corr.mean(), v_corr.sd(), 2);
+    }
+    SECTION("Round Trip") {
+        auto [r, theta] = sigma::to_polar(x, y);
+        auto [u, v]     = sigma::to_cartesian(r, theta);
+        test_uncertain(u, 1.0, 0.1, 2);
+        test_uncertain(v, 2.0, 0.2, 2);
+        test_uncertain(u - x, 0.0, 0.0, 2);
+    }
+    SECTION("Normalize") {
+        auto [nx, ny, nz] = sigma::normalize(x, y, z);
+        auto norm         = sigma::sqrt(x * x + y * y + z * z);
+        auto nx_corr      = x / norm;
+        auto nz_corr      = z / norm;
+        test_uncertain(nx, nx_corr.mean(), nx_corr.sd(), 3);
+        test_uncertain(nz, nz_corr.mean(), nz_corr.sd(), 3);
+        test_uncertain(nx * nx + ny * ny + nz * nz, 1.0, 0.0, 3);
+    }
+    SECTION("Fractional and Integral Parts") {
+        auto [frac, whole] = sigma::modf(testing_t(2.5, 0.1));
+        test_uncertain(frac, 0.5, 0.1, 1);
+        test_uncertain(whole, 2.0, 0.0, 0);
+    }
+    SECTION("Fraction and Exponent") {
+        auto [frac, exponent] = sigma::frexp(testing_t(12.0, 0.8));
+        test_uncertain(frac, 0.75, 0.05, 1);
+        REQUIRE(exponent == 4);
+    }
+}
@@ -0,0 +1,67 @@
+#include "testing.hpp"
+#include <cmath>
+#include <sigma/sigma.hpp>
+
+TEMPLATE_TEST_CASE("Dual", "", float, double) {
+    using value_t   = TestType;
+    using testing_t = sigma::Dual<value_t, 2>;
+
+    auto x = testing_t::variable(2.0, 0);
+    auto y = testing_t::variable(0.5, 1);
+
+    auto check = [](const testing_t& d, double v, double dx, double dy) {
+        REQUIRE(d.value() == Catch::Approx(v));
+        REQUIRE(d.derivative(0) == Catch::Approx(dx).margin(1.0e-6));
+        REQUIRE(d.derivative(1) == Catch::Approx(dy).margin(1.0e-6));
+    };
+
+    SECTION("Constructors") {
+        check(testing_t(), 0.0, 0.0, 0.0);
+        check(testing_t(3.0), 3.0, 0.0, 0.0);
+        check(x, 2.0, 1.0, 0.0);
+        check(y, 0.5, 0.0, 1.0);
+    }
+    SECTION("Arithmetic") {
+        check(-x, -2.0, -1.0, 0.0);
+        check(x + y, 2.5, 1.0, 1.0);
+        check(x - y, 1.5, 1.0, -1.0);
+        check(x * y, 1.0, 0.5, 2.0);
+        check(x / y, 4.0, 2.0, -8.0);
+        check(x * 3.0, 6.0, 3.0, 0.0);
+        check(3 + x, 5.0, 1.0, 0.0);
+        check(1.0 - y, 0.5, 0.0, -1.0);
+        check(1.0 / x, 0.5, -0.25, 0.0);
+        auto z = x;
+        z *= y;
+        z += 1.0;
+        check(z, 2.0, 0.5, 2.0);
+    }
+    SECTION("Comparisons") {
+        REQUIRE(y < x);
+        REQUIRE(x > 1.0);
+        REQUIRE(x == 2.0);
+        REQUIRE(0.5 <= y);
+        REQUIRE_FALSE(x != x);
+    }
+    SECTION("Math Functions") {
+        check(sigma::exp(y), std::exp(0.5), 0.0, std::exp(0.5));
+        check(sigma::log(x), std::log(2.0), 0.5, 0.0);
+        check(sigma::sin(x * y), std::sin(1.0), 0.5 * std::cos(1.0),
+              2.0 * std::cos(1.0));
+        check(sigma::pow(x, 3), 8.0, 12.0, 0.0);
+        check(sigma::pow(2.0, y), std::sqrt(2.0), 0.0,
+              std::log(2.0) * std::sqrt(2.0));
+        check(sigma::pow(x, y), std::sqrt(2.0), 0.5 / std::sqrt(2.0),
+              std::log(2.0) * std::sqrt(2.0));
+        auto h = std::hypot(2.0, 0.5);
+        check(sigma::hypot(x, y), h, 2.0 / h, 0.5 / h);
+        check(sigma::atan2(y, x), std::atan2(0.5, 2.0), -0.5 / 4.25,
+              2.0 / 4.25);
+        check(sigma::abs(-x), 2.0, 1.0, 0.0);
+        check(sigma::lgamma(x), 0.0, 0.4227843, 0.0);
+        check(sigma::tgamma(x), 1.0, 0.4227843, 0.0);
+        check(sigma::sqrt(x), std::sqrt(2.0), 0.5 / std::sqrt(2.0), 0.0);
+        check(sigma::tanh(y), std::tanh(0.5), 0.0,
+              1.0 - std::pow(std::tanh(0.5), 2));
+    }
+}
@@ -0,0 +1,59 @@
+#include "testing.hpp"
+#include <sigma/sigma.hpp>
+#include <stdexcept>
+#include <vector>
+
+using testing::test_uncertain;
+
+TEMPLATE_TEST_CASE("make_independent", "", sigma::UFloat, sigma::UDouble) {
+    using testing_t = TestType;
+    using value_t   = typename testing_t::value_t;
+
+    std::vector<value_t> means{1.0, 2.0, 3.0};
+    std::vector<value_t> sds{0.1, -0.2, 0.3};
+
+    SECTION("Values") {
+        auto values = sigma::make_independent(means, sds);
+        REQUIRE(values.size() == 3);
+        test_uncertain(values[0], 1.0, 0.1, 1);
+        test_uncertain(values[1], 2.0, 0.2, 1);
+        test_uncertain(values[2], 3.0, 0.3, 1);
+    }
+    SECTION("Pointer and size") {
+        auto values = sigma::make_independent(means.data(), sds.data(), 2);
+        REQUIRE(values.size() == 2);
+        test_uncertain(values[0], 1.0, 0.1, 1);
+        test_uncertain(values[1], 2.0, 0.2, 1);
+    }
+    SECTION("Variables are independent") {
+        auto values = sigma::make_independent(means, sds);
+        REQUIRE(values[0] != values[1]);
+        test_uncertain(values[0] + values[1], 3.0, 0.2236, 2);
+        test_uncertain(values[0] - values[0], 0.0, 0.0, 1);
+    }
+    SECTION("Equivalent to individual construction") {
+        auto values = sigma::make_independent(means, sds);
+        auto a      = testing_t(1.0, 0.1);
+        auto b      = testing_t(2.0, -0.2);
+        test_uncertain(values[0] * values[1], 2.0, 0.2828, 2);
+        REQUIRE((values[0] * values[1]).sd() == Catch::Approx((a * b).sd()));
+    }
+    SECTION("Storage outlives the returned vector") {
+        testing_t x;
+        {
+            auto values = sigma::make_independent(means, sds);
+            x           = values[2] * 2.0;
+        }
+        test_uncertain(x, 6.0, 0.6, 1);
+        test_uncertain(x + x, 12.0, 1.2, 1);
+    }
+    SECTION("Empty") {
+        std::vector<value_t> empty;
+        REQUIRE(sigma::make_independent(empty, empty).empty());
+    }
+    SECTION("Mismatched lengths") {
+        std::vector<value_t> short_sds{0.1};
+        REQUIRE_THROWS_AS(sigma::make_independent(means, short_sds),
+                          std::invalid_argument);
+    }
+}
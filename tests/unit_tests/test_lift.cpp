@@ -0,0 +1,58 @@
+#include "testing.hpp"
+#include <sigma/sigma.hpp>
+#include <type_traits>
+
+using testing::test_uncertain;
+
+TEMPLATE_TEST_CASE("lift", "", sigma::UFloat, sigma::UDouble) {
+    using testing_t = TestType;
+
+    auto a = testing_t(1.0, 0.1);
+    auto b = testing_t(2.0, 0.2);
+
+    SECTION("Unary") {
+        auto f = sigma::lift([](auto x) { return sigma::sin(x); });
+        test_uncertain(f(a), 0.8415, 0.0540, 1);
+        REQUIRE(f(a).sd() == Catch::Approx(sigma::sin(a).sd()));
+    }
+    SECTION("Binary") {
+        auto f = sigma::lift([](auto x, auto y) { return x * y; });
+        test_uncertain(f(a, b), 2.0, 0.2828, 2);
+    }
+    SECTION("Matches composed operations") {
+        auto expr = [](auto x, auto y, auto z) {
+            using std::exp;
+            return exp(x) * y / (1.0 + z * z);
+        };
+        auto c        = a * b;
+        auto lifted   = sigma::lift(expr)(a, b, c);
+        auto composed = expr(a, b, c);
+        test_uncertain(lifted, composed.mean(), composed.sd(), 2);
+    }
+    SECTION("Correlated arguments") {
+        auto f = sigma::lift([](auto x, auto y) { return x - y; });
+        test_uncertain(f(a, a), 0.0, 0.0, 1);
+    }
+    SECTION("Constant arguments") {
+        auto f = sigma::lift([](auto x, auto k) { return sigma::pow(x, k); });
+        test_uncertain(f(b, 2.0), 4.0, 0.8, 1);
+    }
+    SECTION("Independent of the arguments") {
+        auto f = sigma::lift([](auto) { return 3.0; });
+        test_uncertain(f(a), 3.0, 0.0, 0);
+    }
+}
+
+TEMPLATE_TEST_CASE("lift with other policies", "", sigma::FlatStorage,
+                   sigma::AdaptiveStorage, sigma::HashStorage,
+                   sigma::NoPropagation) {
+    using testing_t = sigma::Uncertain<double, TestType>;
+
+    testing_t a(1.0, 0.1), b(2.0, 0.2);
+    auto f      = sigma::lift([](auto x, auto y) { return x * sigma::exp(y); });
+    auto lifted = f(a, b);
+    auto composed = a * sigma::exp(b);
+    STATIC_REQUIRE(std::is_same_v<decltype(lifted), testing_t>);
+    test_uncertain(lifted, composed.mean(), composed.sd(),
+                   composed.deps().size());
+}
@@ -0,0 +1,92 @@
+#include "testing.hpp"
+#include <sigma/sigma.hpp>
+#include <vector>
+
+TEMPLATE_TEST_CASE("memory_usage", "", sigma::UFloat, sigma::UDouble) {
+    using testing_t = TestType;
+    using value_t   = typename testing_t::value_t;
+
+    using entry_t   = typename testing_t::deps_map_t::value_type;
+    const auto node = 4 * sizeof(void*) + sizeof(entry_t);
+
+    testing_t x{1.0, 0.1}, y{2.0, 0.2};
+
+    SECTION("Certain value") {
+        auto usage = sigma::memory_usage(testing_t(1.0));
+        REQUIRE(usage.n_entries == 0);
+        REQUIRE(usage.total_bytes() == 0);
+    }
+    SECTION("Single value") {
+        auto usage = sigma::memory_usage(x * y);
+        REQUIRE(usage.n_entries == 2);
+        REQUIRE(usage.n_variables == 2);
+        REQUIRE(usage.deps_bytes == 2 * node);
+        REQUIRE(usage.cells_bytes > 2 * sizeof(value_t));
+        REQUIRE(usage.total_bytes() == usage.deps_bytes + usage.cells_bytes);
+    }
+    SECTION("Shared variables are counted once") {
+        std::vector<testing_t> values{x, x + y, x * y, y};
+        auto usage = sigma::memory_usage(values);
+        REQUIRE(usage.n_entries == 6);
+        REQUIRE(usage.n_variables == 2);
+        REQUIRE(usage.deps_bytes == 6 * node);
+        REQUIRE(usage.cells_bytes == sigma::memory_usage(x + y).cells_bytes);
+    }
+    SECTION("Variables made together share a control block") {
+        std::vector<value_t> means(3, 1.0), sds(3, 0.1);
+        auto block    = sigma::make_independent(means, sds);
+        auto together = sigma::memory_usage(block);
+        std::vector<testing_t> apart{x, y, testing_t{3.0, 0.3}};
+        REQUIRE(together.n_variables == 3);
+        REQUIRE(together.cells_bytes < sigma::memory_usage(apart).cells_bytes);
+    }
+}
+
+TEMPLATE_TEST_CASE("memory_usage with other policies", "", sigma::FlatStorage,
+                   sigma::AdaptiveStorage, sigma::HashStorage,
+                   sigma::NoPropagation) {
+    using testing_t = sigma::Uncertain<double, TestType>;
+
+    testing_t x{1.0, 0.1}, y{2.0, 0.2};
+    std::vector<testing_t> values{x, x + y, x * y, y};
+    auto usage = sigma::memory_usage(values);
+    if constexpr(TestType::propagates) {
+        REQUIRE(usage.n_entries == 6);
+        REQUIRE(usage.n_variables == 2);
+        std::size_t bytes = 0;
+        for(const auto& value : values) {
+            bytes += sigma::detail_::deps_bytes(value.deps());
+        }
+        REQUIRE(usage.deps_bytes == bytes);
+        // One block per value rather than a map node per entry
+        using entry_t = typename testing_t::deps_map_t::value_type;
+        REQUIRE(usage.deps_bytes < 6 * (4 * sizeof(void*) + sizeof(entry_t)));
+    } else {
+        REQUIRE(usage.n_entries == 0);
+        REQUIRE(usage.total_bytes() == 0);
+    }
+}
+
+TEMPLATE_TEST_CASE("live_independent_variables", "", sigma::UFloat,
+                   sigma::UDouble) {
+    using testing_t = TestType;
+    using value_t   = typename testing_t::value_t;
+
+    const auto before = sigma::live_independent_variables();
+    {
+        testing_t x{1.0, 0.1};
+        REQUIRE(sigma::live_independent_variables() == before + 1);
+        testing_t z = x * x + testing_t(2.0);
+        REQUIRE(sigma::live_independent_variables() == before + 1);
+        {
+            std::vector<value_t> means(4, 1.0), sds(4, 0.1);
+            auto values = sigma::make_independent(means, sds);
+            REQUIRE(sigma::live_independent_variables() == before + 5);
+        }
+        REQUIRE(sigma::live_independent_variables() == before + 1);
+        x = testing_t(1.0);
+        // z still depends on the variable
+        REQUIRE(sigma::live_independent_variables() == before + 1);
+    }
+    REQUIRE(sigma::live_independent_variables() == before);
+}
@@ -0,0 +1,171 @@
+#include "testing.hpp"
+#include <algorithm>
+#include <cmath>
+#include <sigma/sigma.hpp>
+#include <type_traits>
+#include <vector>
+
+using testing::test_uncertain;
+
+namespace {
+
+/// A model written once for either policy
+template<typename T, typename P>
+sigma::Uncertain<T, P> model(const sigma::Uncertain<T, P>& a,
+                             const sigma::Uncertain<T, P>& b) {
+    auto c = a * b + sigma::exp(a) / 2.0;
+    c -= sigma::sin(b);
+    auto [r, theta] = sigma::to_polar(a, c);
+    return sigma::pow(r, 2.0) + theta;
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE("FlatStorage", "", sigma::UFloat, sigma::UDouble) {
+    using value_t   = typename TestType::value_t;
+    using testing_t = sigma::Uncertain<value_t, sigma::FlatStorage>;
+
+    SECTION("Same results as MapStorage") {
+        TestType a(1.0, 0.1), b(2.0, 0.2);
+        testing_t flat_a(1.0, 0.1), flat_b(2.0, 0.2);
+        auto map  = model(a, b);
+        auto flat = model(flat_a, flat_b);
+        test_uncertain(flat, map.mean(), map.sd(), 2);
+    }
+    SECTION("Dependencies are sorted") {
+        testing_t sum(0.0);
+        for(int i = 0; i < 10; ++i) sum += testing_t(1.0, 0.1);
+        REQUIRE(sum.deps().size() == 10);
+        REQUIRE(std::is_sorted(sum.deps().begin(), sum.deps().end()));
+        test_uncertain(sum - sum, 0.0, 0.0, 10);
+    }
+}
+
+TEMPLATE_TEST_CASE("AdaptiveStorage", "", sigma::UFloat, sigma::UDouble) {
+    using value_t   = typename TestType::value_t;
+    using testing_t = sigma::Uncertain<value_t, sigma::AdaptiveStorage>;
+
+    SECTION("Same results as MapStorage") {
+        TestType a(1.0, 0.1), b(2.0, 0.2);
+        testing_t adaptive_a(1.0, 0.1), adaptive_b(2.0, 0.2);
+        auto map      = model(a, b);
+        auto adaptive = model(adaptive_a, adaptive_b);
+        test_uncertain(adaptive, map.mean(), map.sd(), 2);
+    }
+    SECTION("Aggregates of many inputs become dense") {
+        const std::size_t n = 200;
+        std::vector<value_t> means(n, 1.0), sds(n, 0.1);
+        auto adaptive_inputs = sigma::make_independent<sigma::AdaptiveStorage>(
+          means, sds);
+        auto map_inputs = sigma::make_independent(means, sds);
+
+        testing_t adaptive_sum(0.0);
+        TestType map_sum(0.0);
+        for(std::size_t i = 0; i < n; ++i) {
+            adaptive_sum += adaptive_inputs[i] * value_t(i % 3);
+            map_sum += map_inputs[i] * value_t(i % 3);
+        }
+        REQUIRE(adaptive_sum.deps().is_dense());
+        test_uncertain(adaptive_sum, map_sum.mean(), map_sum.sd(), n);
+        test_uncertain(adaptive_sum - adaptive_sum, 0.0, 0.0, n);
+    }
+    SECTION("Dense values combined with a separate block") {
+        const std::size_t n = 200, n_far = 100000;
+        std::vector<value_t> means(n, 1.0), sds(n, 0.1);
+        std::vector<value_t> far_means(n_far, 1.0), far_sds(n_far, 0.1);
+        auto inputs = sigma::make_independent<sigma::AdaptiveStorage>(means,
+                                                                      sds);
+        auto far = sigma::make_independent<sigma::AdaptiveStorage>(far_means,
+                                                                   far_sds);
+
+        testing_t x(0.0);
+        for(const auto& input : inputs) x += input;
+        REQUIRE(x.deps().is_dense());
+        auto [r, theta] = sigma::to_polar(x, far[0]);
+        REQUIRE(r.deps().size() == n + 1);
+        REQUIRE(theta.deps().size() == n + 1);
+    }
+}
+
+TEMPLATE_TEST_CASE("HashStorage", "", sigma::UFloat, sigma::UDouble) {
+    using value_t   = typename TestType::value_t;
+    using testing_t = sigma::Uncertain<value_t, sigma::HashStorage>;
+
+    SECTION("Same results as MapStorage") {
+        TestType a(1.0, 0.1), b(2.0, 0.2);
+        testing_t hash_a(1.0, 0.1), hash_b(2.0, 0.2);
+        auto map  = model(a, b);
+        auto hash = model(hash_a, hash_b);
+        test_uncertain(hash, map.mean(), map.sd(), 2);
+    }
+    SECTION("Narrow updates of a wide value") {
+        const std::size_t n = 100;
+        std::vector<value_t> means(n, 1.0), sds(n, 0.1);
+        auto inputs = sigma::make_independent<sigma::HashStorage>(means, sds);
+
+        testing_t total(0.0);
+        for(std::size_t i = n; i-- > 0;) total += inputs[i];
+        REQUIRE(total.deps().is_indexed());
+        total -= inputs[0] * value_t(2.0);
+        test_uncertain(total, n - 2.0, std::sqrt(0.01 * n), n);
+        test_uncertain(total - total, 0.0, 0.0, n);
+    }
+}
+
+TEMPLATE_TEST_CASE("NoPropagation", "", sigma::UFloat, sigma::UDouble) {
+    using value_t   = typename TestType::value_t;
+    using testing_t = sigma::Uncertain<value_t, sigma::NoPropagation>;
+
+    SECTION("Holds only the mean") {
+        STATIC_REQUIRE(sizeof(testing_t) == sizeof(value_t));
+        STATIC_REQUIRE(std::is_trivially_copyable_v<testing_t>);
+    }
+    SECTION("Ctors") {
+        test_uncertain(testing_t(1.5), 1.5, 0.0, 0);
+        test_uncertain(testing_t(1.5, 0.1), 1.5, 0.0, 0);
+    }
+    SECTION("Same means as Propagate") {
+        TestType a(1.0, 0.1), b(2.0, 0.2);
+        testing_t fast_a(1.0, 0.1), fast_b(2.0, 0.2);
+        auto full = model(a, b);
+        auto fast = model(fast_a, fast_b);
+        REQUIRE(fast.mean() == Catch::Approx(full.mean()));
+        REQUIRE(full.sd() > 0.0);
+        test_uncertain(fast, full.mean(), 0.0, 0);
+    }
+    SECTION("Operations evaluate only the means") {
+        TestType a(0.7, 0.1), b(2.5, 0.2);
+        testing_t fast_a(0.7, 0.1), fast_b(2.5, 0.2);
+        auto check = [](const testing_t& fast, const TestType& full) {
+            test_uncertain(fast, full.mean(), 0.0, 0);
+        };
+        check(sigma::lgamma(sigma::sin(fast_a)), sigma::lgamma(sigma::sin(a)));
+        check(sigma::tgamma(fast_b), sigma::tgamma(b));
+        check(sigma::pow(fast_a, fast_b), sigma::pow(a, b));
+        check(sigma::atan2(fast_a, fast_b), sigma::atan2(a, b));
+        check(sigma::fmod(fast_b, fast_a), sigma::fmod(b, a));
+        check(sigma::frexp(fast_b).first, sigma::frexp(b).first);
+        auto fast_polar = sigma::to_polar(fast_a, fast_b);
+        auto full_polar = sigma::to_polar(a, b);
+        check(fast_polar[0], full_polar[0]);
+        check(fast_polar[1], full_polar[1]);
+        auto fast_n = sigma::normalize(fast_a, fast_b, fast_a);
+        auto full_n = sigma::normalize(a, b, a);
+        for(std::size_t i = 0; i < 3; ++i) check(fast_n[i], full_n[i]);
+    }
+    SECTION("Comparisons") {
+        testing_t a(1.0), b(2.0);
+        REQUIRE(a == testing_t(1.0, 0.5));
+        REQUIRE(a != b);
+        REQUIRE(a < b);
+    }
+}
+
+TEMPLATE_TEST_CASE("is_uncertain", "", sigma::MapStorage, sigma::FlatStorage,
+                   sigma::AdaptiveStorage, sigma::HashStorage,
+                   sigma::NoPropagation) {
+    using uncertain_t = sigma::Uncertain<double, TestType>;
+    STATIC_REQUIRE(sigma::detail_::is_uncertain_v<uncertain_t>);
+    STATIC_REQUIRE(sigma::detail_::is_uncertain_v<const uncertain_t&>);
+    STATIC_REQUIRE_FALSE(sigma::detail_::is_uncertain_v<double>);
+}
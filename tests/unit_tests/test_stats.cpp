@@ -0,0 +1,82 @@
+#include "testing.hpp"
+#include <sigma/sigma.hpp>
+#include <vector>
+
+TEMPLATE_TEST_CASE("stats", "", sigma::UFloat, sigma::UDouble) {
+    using testing_t = TestType;
+
+    testing_t x{1.0, 0.1}, y{2.0, 0.2};
+
+    SECTION("Reset") {
+        sigma::reset_stats();
+        auto s = sigma::stats();
+        REQUIRE(s.merges == 0);
+        REQUIRE(s.entries_touched == 0);
+        REQUIRE(s.allocations == 0);
+        REQUIRE(s.sd_updates == 0);
+        REQUIRE(s.peak_deps == 0);
+    }
+    SECTION("Binary operation") {
+        sigma::reset_stats();
+        testing_t z = x + y;
+        auto s      = sigma::stats();
+        if constexpr(sigma::stats_enabled) {
+            // Copy x, then merge y's dependency into the copy
+            REQUIRE(s.merges == 1);
+            REQUIRE(s.allocations == 2);
+            REQUIRE(s.sd_updates == 1);
+            REQUIRE(s.entries_touched == 3);
+            REQUIRE(s.peak_deps == 2);
+        } else {
+            REQUIRE(s.merges == 0);
+            REQUIRE(s.allocations == 0);
+        }
+        REQUIRE(z.deps().size() == 2);
+    }
+    SECTION("Unary operation") {
+        testing_t z = x + y;
+        sigma::reset_stats();
+        auto w = sigma::exp(z);
+        auto s = sigma::stats();
+        if constexpr(sigma::stats_enabled) {
+            REQUIRE(s.merges == 0);
+            REQUIRE(s.allocations == 2);
+            REQUIRE(s.sd_updates == 1);
+        } else {
+            REQUIRE(s.sd_updates == 0);
+        }
+        REQUIRE(w.deps().size() == 2);
+    }
+    SECTION("Independent variables") {
+        sigma::reset_stats();
+        std::vector<typename testing_t::value_t> means(4, 1.0), sds(4, 0.1);
+        auto values = sigma::make_independent(means, sds);
+        auto s      = sigma::stats();
+        if constexpr(sigma::stats_enabled) {
+            // The shared cells, then one map node per variable
+            REQUIRE(s.allocations == 6);
+            REQUIRE(s.sd_updates == 4);
+            REQUIRE(s.peak_deps == 1);
+        } else {
+            REQUIRE(s.allocations == 0);
+        }
+        REQUIRE(values.size() == 4);
+    }
+}
+
+TEST_CASE("stats of copies with contiguous storage") {
+    using testing_t = sigma::Uncertain<double, sigma::FlatStorage>;
+
+    testing_t x{1.0, 0.1}, y{2.0, 0.2};
+    testing_t z = x + y;
+    sigma::reset_stats();
+    testing_t copy = z;
+    auto s         = sigma::stats();
+    if constexpr(sigma::stats_enabled) {
+        // One vector for both entries
+        REQUIRE(s.allocations == 1);
+    } else {
+        REQUIRE(s.allocations == 0);
+    }
+    REQUIRE(copy.deps().size() == 2);
+}
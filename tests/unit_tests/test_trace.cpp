@@ -0,0 +1,105 @@
+#include "testing.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <sigma/sigma.hpp>
+#include <sstream>
+#include <string>
+
+namespace {
+
+template<typename T>
+sigma::Uncertain<T> traced_model(const sigma::Uncertain<T>& x) {
+    SIGMA_TRACE_OP("traced_model", x, 2.0);
+    return sigma::exp(x) * x;
+}
+
+/// The number of traced events
+std::size_t count_events() {
+    std::ostringstream os;
+    sigma::write_chrome_trace(os);
+    const std::string trace = os.str();
+    std::size_t n           = 0;
+    for(auto i = trace.find("\"ph\""); i != std::string::npos;
+        i      = trace.find("\"ph\"", i + 1)) {
+        ++n;
+    }
+    return n;
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE("trace", "", sigma::UFloat, sigma::UDouble) {
+    using testing_t = TestType;
+
+    testing_t x{1.0, 0.1}, y{2.0, 0.2};
+
+    SECTION("Counting dependencies") {
+        REQUIRE(sigma::detail_::trace_deps(x, 2.0) == 1);
+        REQUIRE(sigma::detail_::trace_deps(x + y, y) == 3);
+        REQUIRE(sigma::detail_::trace_deps() == 0);
+    }
+    SECTION("Chrome trace") {
+        sigma::clear_trace();
+        auto z = traced_model(x + y);
+        std::ostringstream os;
+        sigma::write_chrome_trace(os);
+        const std::string trace = os.str();
+
+        REQUIRE(trace.find("\"traceEvents\"") != std::string::npos);
+        const bool has_model =
+          trace.find("\"name\": \"traced_model\"") != std::string::npos;
+        const bool has_exp = trace.find("\"name\": \"exp\"") != std::string::npos;
+        if constexpr(sigma::trace_enabled) {
+            // exp is called within traced_model, so is part of its event
+            REQUIRE(has_model);
+            REQUIRE_FALSE(has_exp);
+            REQUIRE(trace.find("\"deps\": 2") != std::string::npos);
+            REQUIRE(trace.find("\"ph\": \"X\"") != std::string::npos);
+        } else {
+            REQUIRE_FALSE(has_model);
+            REQUIRE_FALSE(has_exp);
+        }
+        REQUIRE(z.deps().size() == 2);
+    }
+    SECTION("One event per operation") {
+        // Both forward to other traced operations
+        const std::size_t expected = sigma::trace_enabled ? 1 : 0;
+        sigma::clear_trace();
+        auto z = 2.0 * x;
+        REQUIRE(count_events() == expected);
+        sigma::clear_trace();
+        z = sigma::hypot(2.0, x);
+        REQUIRE(count_events() == expected);
+        REQUIRE(z.deps().size() == 1);
+    }
+    SECTION("Clear") {
+        sigma::clear_trace();
+        std::ostringstream os;
+        sigma::write_chrome_trace(os);
+        REQUIRE(os.str().find("\"name\"") == std::string::npos);
+    }
+}
+
+TEST_CASE("TraceBuffer") {
+    using buffer_t = sigma::detail_::TraceBuffer;
+    buffer_t buffer(0);
+
+    // Wrap around, so the first events are overwritten
+    const std::int64_t n = buffer_t::capacity + 3;
+    for(std::int64_t i = 0; i < n; ++i) {
+        buffer.push({"event", i, i + 1, static_cast<std::size_t>(i)});
+    }
+    std::int64_t expected = 3;
+    buffer.for_each([&expected](const sigma::detail_::TraceEvent& e) {
+        REQUIRE(e.start == expected);
+        REQUIRE(e.end == expected + 1);
+        REQUIRE(e.deps == static_cast<std::size_t>(expected));
+        ++expected;
+    });
+    REQUIRE(expected == n);
+
+    buffer.clear();
+    std::size_t count = 0;
+    buffer.for_each([&count](const sigma::detail_::TraceEvent&) { ++count; });
+    REQUIRE(count == 0);
+}